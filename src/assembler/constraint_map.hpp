@@ -0,0 +1,237 @@
+#pragma once
+
+/// @file
+
+#include "numeric/block_sparse_matrix.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "numeric/sparse_matrix.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace neon
+{
+/// constraint_map stores the positions in the coefficients of a sparse matrix
+/// that are affected by a set of constrained (Dirichlet) degrees of freedom.
+/// The positions are computed once for each sparsity pattern and set of
+/// constraints, after which the constraints are imposed with a parallel pass
+/// over the stored positions instead of searching the matrix for every
+/// constrained row and column.
+///
+/// Two treatments are provided.  The rows and columns of the constrained
+/// degrees of freedom are either zeroed while retaining the diagonal, or are
+/// removed entirely to form a reduced system containing only the free degrees
+/// of freedom.
+class constraint_map
+{
+public:
+    /// Set the constrained degrees of freedom out of \p size degrees of freedom.
+    /// \return true if the constraints differ from the previous call and the
+    /// positions must be recomputed
+    bool update(std::vector<std::int64_t> dofs, std::int64_t const size)
+    {
+        std::sort(begin(dofs), end(dofs));
+        dofs.erase(std::unique(begin(dofs), end(dofs)), end(dofs));
+
+        if (size == m_size && dofs == m_dofs) return false;
+
+        m_size = size;
+        m_dofs = std::move(dofs);
+
+        is_fixed.assign(m_size, 0);
+        for (auto const dof : m_dofs) is_fixed[dof] = 1;
+
+        m_free_dofs.clear();
+        m_free_dofs.reserve(m_size - m_dofs.size());
+
+        for (std::int64_t dof{0}; dof < m_size; ++dof)
+        {
+            if (!is_fixed[dof]) m_free_dofs.push_back(dof);
+        }
+        return true;
+    }
+
+    /// \return the sorted constrained degrees of freedom
+    [[nodiscard]] auto dofs() const noexcept -> std::vector<std::int64_t> const& { return m_dofs; }
+
+    /// \return the sorted unconstrained degrees of freedom
+    [[nodiscard]] auto free_dofs() const noexcept -> std::vector<std::int64_t> const&
+    {
+        return m_free_dofs;
+    }
+
+    /// Compute the positions of the off-diagonal coefficients in the
+    /// constrained rows and columns of \p A.  Only the stored entries are
+    /// considered such that the upper triangle alone may be stored.
+    void compute_positions(sparse_matrix const& A)
+    {
+        auto const* const outer_index = A.outerIndexPtr();
+        auto const* const inner_index = A.innerIndexPtr();
+
+        positions.clear();
+
+        for (std::int64_t row{0}; row < A.rows(); ++row)
+        {
+            for (auto index = outer_index[row]; index < outer_index[row + 1]; ++index)
+            {
+                auto const col = inner_index[index];
+
+                if ((is_fixed[row] || is_fixed[col]) && col != row) positions.push_back(index);
+            }
+        }
+    }
+
+    /// \sa compute_positions(sparse_matrix const&)
+    template <int BlockSize>
+    void compute_positions(block_sparse_matrix<BlockSize> const& A)
+    {
+        auto constexpr block_size = BlockSize;
+
+        auto const& row_offsets = A.row_offsets();
+        auto const& column_indices = A.column_indices();
+
+        positions.clear();
+
+        for (std::int64_t block_row{0}; block_row < A.block_rows(); ++block_row)
+        {
+            for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index)
+            {
+                for (std::int64_t p{0}; p < block_size; ++p)
+                {
+                    for (std::int64_t q{0}; q < block_size; ++q)
+                    {
+                        auto const row = block_row * block_size + p;
+                        auto const col = column_indices[index] * block_size + q;
+
+                        if ((is_fixed[row] || is_fixed[col]) && col != row)
+                        {
+                            positions.push_back((index * block_size + p) * block_size + q);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Zero the off-diagonal coefficients of the constrained rows and columns
+    /// in \p A, which must have the pattern given to compute_positions, and the
+    /// constrained entries of \p b.  Retaining the diagonal preserves the
+    /// conditioning of the matrix.
+    template <typename MatrixType>
+    void apply(MatrixType& A, vector& b) const
+    {
+        auto* const values = A.valuePtr();
+
+        tbb::parallel_for(std::size_t{0}, positions.size(), [&](auto const index) {
+            values[positions[index]] = 0.0;
+        });
+
+        apply(b);
+    }
+
+    /// Zero the constrained entries of \p b
+    void apply(vector& b) const
+    {
+        for (auto const dof : m_dofs) b(dof) = 0.0;
+    }
+
+    /// Compute the pattern of \p A with the constrained rows and columns
+    /// removed into \p A_reduced, which is numbered by the free degrees of
+    /// freedom.  The ordering of the stored entries is unchanged, such that
+    /// an upper triangle remains an upper triangle.
+    void compute_reduction(sparse_matrix const& A, sparse_matrix& A_reduced)
+    {
+        auto const* const outer_index = A.outerIndexPtr();
+        auto const* const inner_index = A.innerIndexPtr();
+
+        // Position of each degree of freedom in the reduced system
+        std::vector<std::int64_t> reduced_dof(m_size, -1);
+
+        for (std::size_t index{0}; index < m_free_dofs.size(); ++index)
+        {
+            reduced_dof[m_free_dofs[index]] = index;
+        }
+
+        gather_positions.clear();
+
+        A_reduced.resize(m_free_dofs.size(), m_free_dofs.size());
+
+        auto* const reduced_outer_index = A_reduced.outerIndexPtr();
+
+        std::vector<sparse_matrix::StorageIndex> reduced_inner_index;
+
+        for (std::size_t row{0}; row < m_free_dofs.size(); ++row)
+        {
+            auto const dof = m_free_dofs[row];
+
+            for (auto index = outer_index[dof]; index < outer_index[dof + 1]; ++index)
+            {
+                if (!is_fixed[inner_index[index]])
+                {
+                    gather_positions.push_back(index);
+                    reduced_inner_index.push_back(reduced_dof[inner_index[index]]);
+                }
+            }
+            reduced_outer_index[row + 1] = reduced_inner_index.size();
+        }
+
+        A_reduced.resizeNonZeros(reduced_inner_index.size());
+
+        std::copy(begin(reduced_inner_index), end(reduced_inner_index), A_reduced.innerIndexPtr());
+    }
+
+    /// Gather the coefficients of \p A for the free degrees of freedom into
+    /// the reduced matrix computed by compute_reduction
+    void reduce(sparse_matrix const& A, sparse_matrix& A_reduced) const
+    {
+        auto const* const values = A.valuePtr();
+        auto* const reduced_values = A_reduced.valuePtr();
+
+        tbb::parallel_for(std::size_t{0}, gather_positions.size(), [&](auto const index) {
+            reduced_values[index] = values[gather_positions[index]];
+        });
+    }
+
+    /// Gather the entries of \p b for the free degrees of freedom
+    void reduce(vector const& b, vector& b_reduced) const
+    {
+        b_reduced.resize(m_free_dofs.size());
+
+        for (std::size_t index{0}; index < m_free_dofs.size(); ++index)
+        {
+            b_reduced(index) = b(m_free_dofs[index]);
+        }
+    }
+
+    /// Scatter the reduced solution \p x_reduced into \p x where the
+    /// constrained degrees of freedom are set to zero
+    void expand(vector const& x_reduced, vector& x) const
+    {
+        x = vector::Zero(m_size);
+
+        for (std::size_t index{0}; index < m_free_dofs.size(); ++index)
+        {
+            x(m_free_dofs[index]) = x_reduced(index);
+        }
+    }
+
+protected:
+    /// Total number of degrees of freedom
+    std::int64_t m_size{-1};
+
+    /// Sorted constrained degrees of freedom
+    std::vector<std::int64_t> m_dofs;
+    /// Sorted unconstrained degrees of freedom
+    std::vector<std::int64_t> m_free_dofs;
+    /// Flag for each degree of freedom with a constraint
+    std::vector<char> is_fixed;
+
+    /// Coefficient positions in the constrained rows and columns
+    std::vector<std::int64_t> positions;
+    /// Coefficient position in the full matrix for each reduced coefficient
+    std::vector<std::int64_t> gather_positions;
+};
+}
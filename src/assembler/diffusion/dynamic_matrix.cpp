@@ -3,11 +3,10 @@
 
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "solver/linear/linear_solver.hpp"
-#include "numeric/doublet.hpp"
+#include "assembler/sparsity_pattern.hpp"
 #include "io/json.hpp"
 
 #include <termcolor/termcolor.hpp>
-#include <tbb/parallel_for.h>
 
 #include <chrono>
 
@@ -75,46 +74,24 @@ void dynamic_matrix::solve()
 
 void dynamic_matrix::assemble_mass()
 {
-    M.resize(mesh.active_dofs(), mesh.active_dofs());
+    // The mass matrix shares the sparsity pattern and scatter map of the
+    // conductivity matrix
+    if (!is_sparsity_computed) compute_sparsity_pattern();
 
-    std::vector<doublet<int>> doublets;
-    doublets.reserve(mesh.active_dofs());
-
-    for (auto const& submesh : mesh.meshes())
-    {
-        for (std::int64_t element = 0; element < submesh.elements(); element++)
-        {
-            auto const dof_view = submesh.local_dof_view(element);
-
-            for (std::int64_t p{0}; p < dof_view.size(); ++p)
-            {
-                for (std::int64_t q{0}; q < dof_view.size(); ++q)
-                {
-                    doublets.emplace_back(dof_view(p), dof_view(q));
-                }
-            }
-        }
-    }
-    M.setFromTriplets(doublets.begin(), doublets.end());
-
-    doublets.clear();
+    M = K;
+    M.coeffs() = 0.0;
 
     auto const start = std::chrono::steady_clock::now();
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        for (std::int64_t element = 0; element < submesh.elements(); ++element)
-        {
+        auto const& submesh = mesh.meshes()[index];
+
+        colourings[index].parallel_for([&](auto const element) {
             auto const& [dofs, m] = submesh.consistent_mass(element);
 
-            for (std::int64_t a{0}; a < dofs.size(); a++)
-            {
-                for (std::int64_t b{0}; b < dofs.size(); b++)
-                {
-                    M.add_to(dofs(a), dofs(b), m(a, b));
-                }
-            }
-        }
+            scatter_add(M, scatter_maps[index].col(element), m);
+        });
     }
 
     auto const end = std::chrono::steady_clock::now();
@@ -4,11 +4,9 @@
 #include "exceptions.hpp"
 #include "solver/linear/linear_solver_factory.hpp"
 #include "assembler/homogeneous_dirichlet.hpp"
-#include "numeric/doublet.hpp"
+#include "assembler/sparsity_pattern.hpp"
 #include "io/json.hpp"
 
-#include <tbb/parallel_for.h>
-
 #include <chrono>
 
 namespace neon::diffusion
@@ -25,28 +23,10 @@ static_matrix::~static_matrix() = default;
 
 void static_matrix::compute_sparsity_pattern()
 {
-    std::vector<doublet<std::int32_t>> doublets;
-    doublets.reserve(mesh.active_dofs());
-
-    K.resize(mesh.active_dofs(), mesh.active_dofs());
-
-    for (auto const& submesh : mesh.meshes())
-    {
-        // Loop over the elements and add in the non-zero components
-        for (std::int64_t element{0}; element < submesh.elements(); element++)
-        {
-            auto const dof_view = submesh.local_dof_view(element);
+    neon::compute_sparsity_pattern(K, mesh);
 
-            for (std::int64_t p{0}; p < dof_view.size(); ++p)
-            {
-                for (std::int64_t q{0}; q < dof_view.size(); ++q)
-                {
-                    doublets.emplace_back(dof_view(p), dof_view(q));
-                }
-            }
-        }
-    }
-    K.setFromTriplets(begin(doublets), end(doublets));
+    colourings = colour_elements(mesh);
+    scatter_maps = compute_scatter_map(K, mesh);
 
     is_sparsity_computed = true;
 }
@@ -128,18 +108,14 @@ void static_matrix::assemble_stiffness()
 
     K.coeffs() = 0.0;
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+        auto const& submesh = mesh.meshes()[index];
+
+        colourings[index].parallel_for([&](auto const element) {
             auto const& [dof_view, local_tangent] = submesh.tangent_stiffness(element);
 
-            for (std::int64_t a{0}; a < dof_view.size(); a++)
-            {
-                for (std::int64_t b{0}; b < dof_view.size(); b++)
-                {
-                    K.add_to(dof_view(a), dof_view(b), local_tangent(a, b));
-                }
-            }
+            scatter_add(K, scatter_maps[index].col(element), local_tangent);
         });
     }
 
@@ -4,6 +4,7 @@
 /// @file
 
 #include "io/file_output.hpp"
+#include "graph/element_colouring.hpp"
 #include "mesh/diffusion/heat/mesh.hpp"
 #include "numeric/sparse_matrix.hpp"
 
@@ -36,9 +37,8 @@ public:
     virtual void solve();
 
 protected:
-    /// Compute the sparse pattern of the coefficient matrix but use the doublet
-    /// list as a means of forming the sparsity pattern.  This is a memory
-    /// intensive operation and should be replaced in the future
+    /// Compute the sparse pattern of the coefficient matrix, the element
+    /// colouring and the scatter map used for assembly
     void compute_sparsity_pattern();
 
     /// Assembles the external contribution vector
@@ -52,6 +52,10 @@ protected:
 
     /// Cache flag for matrix assembly
     bool is_sparsity_computed{false};
+    /// Element colouring for each submesh for conflict free assembly
+    std::vector<element_colouring> colourings;
+    /// Location of each element matrix entry in the coefficients of K
+    std::vector<indices> scatter_maps;
     /// Conductivity matrix
     sparse_matrix K;
     /// Heat vector
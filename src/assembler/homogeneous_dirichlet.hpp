@@ -1,20 +1,64 @@
-
 #pragma once
 
 /// @file
 
+#include <tbb/parallel_for.h>
+
+#include <cstdint>
 #include <vector>
 
 namespace neon
 {
+namespace detail
+{
+/// \return a flag for each of the \p size degrees of freedom that is set for
+/// the degrees of freedom with a Dirichlet condition in \p mesh
+template <typename MeshType>
+[[nodiscard]] auto dirichlet_mask(MeshType const& mesh, std::int64_t const size) -> std::vector<char>
+{
+    std::vector<char> is_fixed(size, 0);
+
+    for (auto const& [name, dirichlet_boundaries] : mesh.dirichlet_boundaries())
+    {
+        for (auto const& dirichlet_boundary : dirichlet_boundaries)
+        {
+            for (auto const fixed_dof : dirichlet_boundary.dof_view())
+            {
+                is_fixed[fixed_dof] = 1;
+            }
+        }
+    }
+    return is_fixed;
+}
+
+/// Zero the off-diagonal coefficients in the rows and the columns of \p A
+/// flagged in \p is_fixed in a single parallel pass over the non-zeros
+template <typename SparseMatrixType>
+void zero_rows_and_columns(SparseMatrixType& A, std::vector<char> const& is_fixed)
+{
+    auto const* const outer_index = A.outerIndexPtr();
+    auto const* const inner_index = A.innerIndexPtr();
+    auto* const values = A.valuePtr();
+
+    tbb::parallel_for(std::int64_t{0}, std::int64_t{A.outerSize()}, [&](auto const outer) {
+        for (auto index = outer_index[outer]; index < outer_index[outer + 1]; ++index)
+        {
+            auto const inner = inner_index[index];
+
+            if ((is_fixed[outer] || is_fixed[inner]) && inner != outer) values[index] = 0.0;
+        }
+    });
+}
+}
+
 /// Apply dirichlet conditions to the system defined by A, x, and b.
 /// This method selects the row and column of the degree of freedom with an
 /// imposed Dirichlet condition.
-/// The algorithm takes the row and performs a zeroing operation on it.  To
-/// satisfy the equation system, the constrained column is multiplied with
-/// the Dirichlet value and subtracted from the matching DoF on the right
-/// hand side vector.  The column is then zeroed and the diagonal DoF is
-/// then corrected such that \f$ A_{dof} * x_{dof} = f_{dof} == A_{dof} * x_{dof} \f$ so the
+/// To satisfy the equation system, the constrained columns are multiplied with
+/// the Dirichlet values and subtracted from the right hand side vector.  The
+/// off-diagonal entries of the constrained rows and columns are then zeroed in
+/// a single pass over the matrix and the constrained right hand side entries
+/// are corrected such that \f$ A_{dof} * x_{dof} = f_{dof} == A_{dof} * x_{dof} \f$ so the
 /// equation system is satisfied.
 /// For inner and outer vector reference see
 /// https://eigen.tuxfamily.org/dox/group__TutorialSparse.html
@@ -25,11 +69,11 @@ namespace neon
 template <typename SparseMatrixType, typename VectorType, typename MeshType>
 void apply_dirichlet_conditions(SparseMatrixType& A, VectorType& x, VectorType& b, MeshType const& mesh)
 {
-    using index_type = typename SparseMatrixType::StorageIndex;
+    A.makeCompressed();
+
+    auto const is_fixed = detail::dirichlet_mask(mesh, A.rows());
 
-    // Keep track of entries we have visited as we walk to the sparse matrix A
-    std::vector<index_type> non_zero_visitor;
-    non_zero_visitor.reserve(A.nonZeros() / A.rows());
+    VectorType x_fixed = VectorType::Zero(x.size());
 
     for (auto const& [name, dirichlet_boundaries] : mesh.dirichlet_boundaries())
     {
@@ -37,45 +81,29 @@ void apply_dirichlet_conditions(SparseMatrixType& A, VectorType& x, VectorType&
         {
             for (auto const fixed_dof : dirichlet_boundary.dof_view())
             {
-                x(fixed_dof) = dirichlet_boundary.value_view();
-
-                auto const diagonal_entry = A.coeff(fixed_dof, fixed_dof);
-
-                non_zero_visitor.clear();
-
-                for (typename SparseMatrixType::InnerIterator it(A, fixed_dof); it; ++it)
-                {
-                    if (!A.IsRowMajor) b(it.row()) -= it.value() * x(fixed_dof);
-
-                    it.valueRef() = 0.0;
-
-                    non_zero_visitor.push_back(A.IsRowMajor ? it.col() : it.row());
-                }
+                x(fixed_dof) = x_fixed(fixed_dof) = dirichlet_boundary.value_view();
+            }
+        }
+    }
 
-                for (auto const& non_zero : non_zero_visitor)
-                {
-                    auto const row = A.IsRowMajor ? non_zero : fixed_dof;
-                    auto const col = A.IsRowMajor ? fixed_dof : non_zero;
+    // Move the constrained columns to the right hand side
+    b -= A * x_fixed;
 
-                    if (A.IsRowMajor) b(row) -= A.coeff(row, col) * x(fixed_dof);
+    detail::zero_rows_and_columns(A, is_fixed);
 
-                    A.coeffRef(row, col) = 0.0;
-                }
-                // Reset the diagonal to the same value in an attempt to
-                // preserve condition number
-                A.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
-                b(fixed_dof) = diagonal_entry * x(fixed_dof);
-            }
-        }
+    for (std::int64_t dof{0}; dof < A.rows(); ++dof)
+    {
+        // The diagonal is retained in an attempt to preserve condition number
+        if (is_fixed[dof]) b(dof) = A.coeff(dof, dof) * x(dof);
     }
 }
 
 /// Apply dirichlet conditions to the system defined by two sparse matrices A.
 /// This method selects the row and column of the degree of freedom with an
 /// imposed Dirichlet condition.
-/// The algorithm takes the row and performs a zeroing operation on it.
-/// The column is then zeroed and the diagonal DoF is
-/// then corrected such that \f$ A_{dof} * x_{dof} = f_{dof} == A_{dof} * x_{dof} \f$ so the
+/// The off-diagonal entries of the constrained rows and columns are zeroed in
+/// a single pass over the matrix, while the diagonal is retained such that
+/// \f$ A_{dof} * x_{dof} = f_{dof} == A_{dof} * x_{dof} \f$ so the
 /// equation system would be satisfied.
 /// For inner and outer vector reference see
 /// https://eigen.tuxfamily.org/dox/group__TutorialSparse.html
@@ -84,41 +112,8 @@ void apply_dirichlet_conditions(SparseMatrixType& A, VectorType& x, VectorType&
 template <typename SparseMatrixType, typename MeshType>
 void apply_dirichlet_conditions(SparseMatrixType& A, MeshType const& mesh)
 {
-    using index_type = typename SparseMatrixType::StorageIndex;
+    A.makeCompressed();
 
-    // Keep track of entries we have visited as we walk to the sparse matrix A
-    std::vector<index_type> non_zero_visitor;
-    non_zero_visitor.reserve(A.nonZeros() / A.rows());
-
-    for (auto const& [name, dirichlet_boundaries] : mesh.dirichlet_boundaries())
-    {
-        for (auto const& dirichlet_boundary : dirichlet_boundaries)
-        {
-            for (auto const fixed_dof : dirichlet_boundary.dof_view())
-            {
-                auto const diagonal_entry = A.coeff(fixed_dof, fixed_dof);
-
-                non_zero_visitor.clear();
-
-                for (typename SparseMatrixType::InnerIterator it(A, fixed_dof); it; ++it)
-                {
-                    it.valueRef() = 0.0;
-
-                    non_zero_visitor.push_back(A.IsRowMajor ? it.col() : it.row());
-                }
-
-                for (auto const& non_zero : non_zero_visitor)
-                {
-                    auto const row = A.IsRowMajor ? non_zero : fixed_dof;
-                    auto const col = A.IsRowMajor ? fixed_dof : non_zero;
-
-                    A.coeffRef(row, col) = 0.0;
-                }
-                // Reset the diagonal to the same value in an attempt to
-                // preserve condition number
-                A.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
-            }
-        }
-    }
+    detail::zero_rows_and_columns(A, detail::dirichlet_mask(mesh, A.rows()));
 }
 }
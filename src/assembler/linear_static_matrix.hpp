@@ -6,13 +6,12 @@
 #include "solver/linear/linear_solver.hpp"
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "assembler/sparsity_pattern.hpp"
+#include "graph/element_colouring.hpp"
 #include "io/file_output.hpp"
 #include "io/json.hpp"
 #include "solver/adaptive_time_step.hpp"
 #include "solver/linear/linear_solver_factory.hpp"
 
-#include <tbb/parallel_for.h>
-
 #include <chrono>
 #include <iostream>
 #include <variant>
@@ -64,6 +63,10 @@ protected:
     vector d;
     /// Cache the sparsity pattern
     bool is_sparsity_computed{false};
+    /// Element colouring for each submesh for conflict free assembly
+    std::vector<element_colouring> colourings;
+    /// Location of each element matrix entry in the coefficients of Kt
+    std::vector<indices> scatter_maps;
 };
 
 template <typename fem_mesh_type>
@@ -140,24 +143,20 @@ void linear_static_matrix<fem_mesh_type>::assemble_stiffness()
     if (!is_sparsity_computed)
     {
         compute_sparsity_pattern(Kt, fem_mesh);
+        colourings = colour_elements(fem_mesh);
+        scatter_maps = compute_scatter_map(Kt, fem_mesh);
         is_sparsity_computed = true;
     }
 
     Kt.coeffs() = 0.0;
 
-    for (auto const& submesh : fem_mesh.meshes())
+    for (std::size_t index{0}; index < fem_mesh.meshes().size(); ++index)
     {
-        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
-            auto const dof_indices = submesh.local_dof_view(element);
-            auto const& ke = submesh.tangent_stiffness(element);
+        auto const& submesh = fem_mesh.meshes()[index];
 
-            for (std::int64_t b{0}; b < dof_indices.size(); b++)
-            {
-                for (std::int64_t a{0}; a < dof_indices.size(); a++)
-                {
-                    Kt.add_to(dof_indices(a), dof_indices(b), ke(a, b));
-                }
-            }
+        // Elements of the same colour do not share degrees of freedom
+        colourings[index].parallel_for([&](auto const element) {
+            scatter_add(Kt, scatter_maps[index].col(element), submesh.tangent_stiffness(element));
         });
     }
 
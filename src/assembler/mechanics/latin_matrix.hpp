@@ -23,6 +23,7 @@ private:
     using base_type::adaptive_load;
     using base_type::apply_displacement_boundaries;
     using base_type::assemble_stiffness;
+    using base_type::colourings;
     using base_type::compute_external_force;
     using base_type::compute_internal_force;
     using base_type::delta_d;
@@ -39,6 +40,15 @@ private:
     using base_type::print_convergence_progress;
     using base_type::solver;
     using base_type::update_relative_norms;
+    using base_type::storage;
+    using base_type::constraints;
+    using base_type::update_constraints;
+    using base_type::use_elimination;
+    using base_type::method;
+    using base_type::use_line_search;
+    using base_type::use_inexact_newton;
+    using base_type::predict_displacement;
+    using base_type::save_converged_displacement;
 
 private:
     /// LATIN residual vector
@@ -78,6 +88,28 @@ latin_matrix<MeshType>::latin_matrix(mesh_type& mesh, json const& simulation)
 
     latin_search_direction = nonlinear_options["latin_search_direction"];
 
+    if (storage != matrix_storage::compressed)
+    {
+        throw std::domain_error("Only \"compressed\" storage is supported by the LATIN solver");
+    }
+    if (method != nonlinear_method::newton)
+    {
+        throw std::domain_error("Only the \"newton\" method is supported by the LATIN solver");
+    }
+    if (use_line_search)
+    {
+        throw std::domain_error("\"line_search\" is not supported by the LATIN solver");
+    }
+    if (use_inexact_newton)
+    {
+        throw std::domain_error("\"inexact_newton\" is not supported by the LATIN solver");
+    }
+    if (use_elimination)
+    {
+        throw std::domain_error("Only \"masked\" Dirichlet conditions are supported by the LATIN "
+                                "solver");
+    }
+
     latin_residual = vector::Zero(mesh.active_dofs());
 }
 
@@ -86,114 +118,72 @@ void latin_matrix<MeshType>::compute_incremental_latin_internal_force()
 {
     latin_residual.setZero();
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        for (std::int64_t element{0}; element < submesh.elements(); ++element)
-        {
+        auto const& submesh = mesh.meshes()[index];
+
+        colourings[index].parallel_for([&](auto const element) {
             auto const
                 & [dofs, fe_int] = submesh.incremental_latin_internal_force(element,
                                                                             latin_search_direction);
 
             latin_residual(dofs) += fe_int;
-        }
+        });
     }
 }
 
 template <class MeshType>
 void latin_matrix<MeshType>::enforce_dirichlet_conditions(sparse_matrix& A, vector& b, vector& c) const
 {
-    for (auto const& [name, boundaries] : mesh.dirichlet_boundaries())
+    constraints.apply(A, b);
+
+    for (auto const fixed_dof : constraints.dofs())
     {
-        for (auto const& boundary : boundaries)
-        {
-            if (boundary.is_not_active(adaptive_load.step_time()))
-            {
-                continue;
-            }
-
-            for (auto const& fixed_dof : boundary.dof_view())
-            {
-                auto const diagonal_entry = A.coeff(fixed_dof, fixed_dof);
-
-                b(fixed_dof) = 0.0;
-
-                c(fixed_dof) = 0.0;
-
-                std::vector<std::int32_t> non_zero_visitor;
-
-                // Zero the rows and columns
-                for (sparse_matrix::InnerIterator it(A, fixed_dof); it; ++it)
-                {
-                    // Set the value of the col or row resp. to zero
-                    it.valueRef() = 0.0;
-                    non_zero_visitor.push_back(A.IsRowMajor ? it.col() : it.row());
-                }
-
-                // Zero the row or col respectively
-                for (auto const& non_zero : non_zero_visitor)
-                {
-                    const auto row = A.IsRowMajor ? non_zero : fixed_dof;
-                    const auto col = A.IsRowMajor ? fixed_dof : non_zero;
-
-                    A.coeffRef(row, col) = 0.0;
-                }
-                // Reset the diagonal to the same value to preserve conditioning
-                A.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
-            }
-        }
+        c(fixed_dof) = 0.0;
     }
 }
 
 template <class MeshType>
 void latin_matrix<MeshType>::solve()
 {
-    try
-    {
-        // Initialise the mesh with zero displacements
-        mesh.update_internal_variables(displacement);
-        mesh.update_internal_forces(f_int);
+    // Initialise the mesh with zero displacements
+    mesh.update_internal_variables(displacement);
+    mesh.update_internal_forces(f_int);
 
-        mesh.write(adaptive_load.step(), adaptive_load.time());
+    mesh.write(adaptive_load.step(), adaptive_load.time());
 
-        while (!adaptive_load.is_fully_applied())
-        {
-            std::cout << "\n"
-                      << std::string(4, ' ') << termcolor::magenta << termcolor::bold
-                      << "Performing equilibrium iterations for time " << adaptive_load.step_time()
-                      << termcolor::reset << std::endl;
+    while (!adaptive_load.is_fully_applied())
+    {
+        std::cout << "\n"
+                  << std::string(4, ' ') << termcolor::magenta << termcolor::bold
+                  << "Performing equilibrium iterations for time " << adaptive_load.step_time()
+                  << termcolor::reset << std::endl;
 
+        try
+        {
             compute_external_force();
 
             perform_equilibrium_iterations();
         }
-    }
-    catch (computational_error& comp_error)
-    {
-        // A numerical error has been reported that is able to be recovered
-        // by resetting the state
-        std::cout << std::endl
-                  << std::string(6, ' ') << termcolor::bold << termcolor::yellow
-                  << comp_error.what() << termcolor::reset << std::endl;
-
-        adaptive_load.update_convergence_state(false);
-        mesh.save_internal_variables(false);
-
-        displacement = displacement_old;
-
-        this->solve();
-    }
-    catch (...)
-    {
-        throw;
+        catch (computational_error& comp_error)
+        {
+            // A numerical error has been reported that is able to be recovered
+            // by resetting the state to the last converged increment, where the
+            // displacement is reset at the start of the next attempt
+            std::cout << std::endl
+                      << std::string(6, ' ') << termcolor::bold << termcolor::yellow
+                      << comp_error.what() << termcolor::reset << std::endl;
+
+            adaptive_load.update_convergence_state(false);
+            mesh.save_internal_variables(false);
+        }
     }
 }
 
 template <class MeshType>
 void latin_matrix<MeshType>::perform_equilibrium_iterations()
 {
-    displacement = displacement_old;
-
-    mesh.update_internal_variables(displacement, adaptive_load.increment());
+    predict_displacement();
 
     // Full LATIN iteration to solve nonlinear equations
     auto current_iteration{0};
@@ -224,6 +214,8 @@ void latin_matrix<MeshType>::perform_equilibrium_iterations()
         // TODO: the convergence may be measure by the minus_residual = latin_residual. However, this
         // will not ensure the balance of forces anymore. Also, the stifness matrix may be scaled by
         // `latin_search_direction` but this did not improve the convergence of the incremental LATIN scheme
+        update_constraints();
+
         enforce_dirichlet_conditions(Kt, minus_residual, latin_residual);
 
         solver->solve(Kt, delta_d, latin_residual);
@@ -252,11 +244,22 @@ void latin_matrix<MeshType>::perform_equilibrium_iterations()
 
     if (current_iteration != maximum_iterations)
     {
-        displacement_old = displacement;
+        // The displacement is overwritten at the start of the next increment
+        displacement_old.swap(displacement);
+
+        adaptive_load.update_convergence_state(current_iteration != maximum_iterations,
+                                               current_iteration + 1);
+        auto const commit_start = std::chrono::steady_clock::now();
 
-        adaptive_load.update_convergence_state(current_iteration != maximum_iterations);
         mesh.save_internal_variables(current_iteration != maximum_iterations);
 
+        auto const commit_end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> const commit_seconds = commit_end - commit_start;
+        std::cout << std::string(6, ' ') << "Internal variable commit took "
+                  << commit_seconds.count() << "s\n";
+
+        save_converged_displacement();
+
         mesh.update_internal_forces(f_int);
 
         mesh.write(adaptive_load.step(), adaptive_load.time());
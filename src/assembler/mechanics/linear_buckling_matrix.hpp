@@ -62,24 +62,19 @@ void linear_buckling_matrix<MeshType>::assemble_stiffness()
 {
     compute_sparsity_pattern(K, mesh);
 
+    auto const scatter_maps = compute_scatter_map(K, mesh);
+
     auto const start = std::chrono::steady_clock::now();
 
     K.coeffs() = 0.0;
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
+        auto const& submesh = mesh.meshes()[index];
+
         for (std::int64_t element = 0; element < submesh.elements(); ++element)
         {
-            auto const dof_indices = submesh.local_dof_view(element);
-            auto const& ke = submesh.tangent_stiffness(element);
-
-            for (std::int64_t a{0}; a < dof_indices.size(); a++)
-            {
-                for (std::int64_t b{0}; b < dof_indices.size(); b++)
-                {
-                    K.add_to(dof_indices(a), dof_indices(b), ke(a, b));
-                }
-            }
+            scatter_add(K, scatter_maps[index].col(element), submesh.tangent_stiffness(element));
         }
     }
 
@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file
+
+#include "graph/element_colouring.hpp"
+#include "solver/linear/linear_operator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace neon::mechanics
+{
+/// matrix_free_operator applies the tangent stiffness matrix of a mesh to a
+/// vector element by element without forming the global matrix.  The element
+/// products are evaluated at the quadrature points from the tangent operators
+/// and the stresses of the current state of the mesh, such that the memory
+/// required is independent of the number of non-zeros in the matrix.
+///
+/// Dirichlet conditions are imposed on the operator by removing the rows and
+/// the columns of the constrained degrees of freedom while retaining the
+/// diagonal, which matches the treatment of an assembled matrix.
+template <class MeshType>
+class matrix_free_operator : public linear_operator
+{
+public:
+    using mesh_type = MeshType;
+
+public:
+    /// Construct the operator for \p mesh, where the elements are evaluated in
+    /// parallel using the element colouring of each submesh
+    explicit matrix_free_operator(mesh_type const& mesh,
+                                  std::vector<element_colouring> const& colourings)
+        : mesh(mesh), colourings(colourings)
+    {
+    }
+
+    /// Compute the diagonal for the current state of the mesh and remove any
+    /// constraints.  This must be called after updating the internal variables.
+    void update()
+    {
+        m_diagonal = vector::Zero(mesh.active_dofs());
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            colourings[index].parallel_for([&](auto const element) {
+                m_diagonal(submesh.local_dof_view(element)) += submesh.tangent_stiffness_diagonal(
+                    element);
+            });
+        }
+        is_constrained.assign(mesh.active_dofs(), 0);
+    }
+
+    /// Remove the row and the column of \p dof from the operator
+    void constrain(std::int64_t const dof) { is_constrained[dof] = 1; }
+
+    [[nodiscard]] auto rows() const -> std::int64_t override { return mesh.active_dofs(); }
+
+    /// Compute \p y = A * \p x by accumulating the element products
+    void multiply(vector const& x, vector& y) const override
+    {
+        constrained_input = x;
+
+        for (std::size_t dof{0}; dof < is_constrained.size(); ++dof)
+        {
+            if (is_constrained[dof]) constrained_input(dof) = 0.0;
+        }
+
+        y = vector::Zero(x.size());
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            // Elements of the same colour do not share degrees of freedom
+            colourings[index].parallel_for([&](auto const element) {
+                thread_local vector local_input;
+
+                auto const dof_view = submesh.local_dof_view(element);
+
+                local_input = constrained_input(dof_view);
+
+                y(dof_view) += submesh.tangent_stiffness_product(element, local_input);
+            });
+        }
+
+        for (std::size_t dof{0}; dof < is_constrained.size(); ++dof)
+        {
+            if (is_constrained[dof]) y(dof) = m_diagonal(dof) * x(dof);
+        }
+    }
+
+    [[nodiscard]] auto diagonal() const -> vector const& override { return m_diagonal; }
+
+    /// \return the operator vector product A * \p x
+    [[nodiscard]] auto operator*(vector const& x) const -> vector
+    {
+        vector y;
+        multiply(x, y);
+        return y;
+    }
+
+protected:
+    mesh_type const& mesh;
+
+    /// Element colouring for each submesh
+    std::vector<element_colouring> const& colourings;
+
+    /// Diagonal of the tangent stiffness matrix
+    vector m_diagonal;
+
+    /// Flag for each degree of freedom with a Dirichlet condition
+    std::vector<char> is_constrained;
+
+    /// Input vector with the constrained entries removed
+    mutable vector constrained_input;
+};
+}
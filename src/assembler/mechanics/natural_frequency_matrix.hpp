@@ -7,6 +7,7 @@
 
 #include "assembler/sparsity_pattern.hpp"
 #include "assembler/homogeneous_dirichlet.hpp"
+#include "graph/element_colouring.hpp"
 #include "solver/eigen/arpack.hpp"
 
 #include <chrono>
@@ -46,6 +47,11 @@ protected:
     /// Mass matrix
     sparse_matrix M;
 
+    /// Element colouring for each submesh for conflict free assembly
+    std::vector<element_colouring> colourings;
+    /// Location of each element matrix entry in the coefficients of K and M
+    std::vector<indices> scatter_maps;
+
     /// Eigenvalue solver
     std::unique_ptr<eigen_solver> solver;
 
@@ -75,23 +81,19 @@ void natural_frequency_matrix<MeshType>::assemble_stiffness()
 {
     compute_sparsity_pattern(K, mesh);
 
+    colourings = colour_elements(mesh);
+    scatter_maps = compute_scatter_map(K, mesh);
+
     auto const start = std::chrono::steady_clock::now();
 
     K.coeffs() = 0.0;
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
-            auto const dof_indices = submesh.local_dof_view(element);
-            auto const& local_tangent = submesh.tangent_stiffness(element);
-
-            for (std::int64_t a{0}; a < dof_indices.size(); a++)
-            {
-                for (std::int64_t b{0}; b < dof_indices.size(); b++)
-                {
-                    K.add_to(dof_indices(a), dof_indices(b), local_tangent(a, b));
-                }
-            }
+        auto const& submesh = mesh.meshes()[index];
+
+        colourings[index].parallel_for([&](auto const element) {
+            scatter_add(K, scatter_maps[index].col(element), submesh.tangent_stiffness(element));
         });
     }
 
@@ -108,23 +110,21 @@ void natural_frequency_matrix<MeshType>::assemble_mass()
 {
     compute_sparsity_pattern(M, mesh);
 
+    if (colourings.empty()) colourings = colour_elements(mesh);
+
+    // The stiffness and mass matrices share the same sparsity pattern
+    if (scatter_maps.empty()) scatter_maps = compute_scatter_map(M, mesh);
+
     auto const start = std::chrono::steady_clock::now();
 
     M.coeffs() = 0.0;
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
-            auto const dof_indices = submesh.local_dof_view(element);
-            auto const& local_mass = submesh.consistent_mass(element);
-
-            for (std::int64_t a{0}; a < dof_indices.size(); a++)
-            {
-                for (std::int64_t b{0}; b < dof_indices.size(); b++)
-                {
-                    M.add_to(dof_indices(a), dof_indices(b), local_mass(a, b));
-                }
-            }
+        auto const& submesh = mesh.meshes()[index];
+
+        colourings[index].parallel_for([&](auto const element) {
+            scatter_add(M, scatter_maps[index].col(element), submesh.consistent_mass(element));
         });
     }
 
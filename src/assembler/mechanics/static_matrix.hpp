@@ -3,15 +3,22 @@
 
 /// @file
 
+#include "assembler/constraint_map.hpp"
+#include "assembler/mechanics/matrix_free_operator.hpp"
 #include "assembler/sparsity_pattern.hpp"
+#include "graph/element_colouring.hpp"
+#include "numeric/block_sparse_matrix.hpp"
 #include "numeric/float_compare.hpp"
 #include "exceptions.hpp"
 #include "numeric/sparse_matrix.hpp"
 #include "solver/adaptive_time_step.hpp"
+#include "solver/limited_memory_bfgs.hpp"
 #include "solver/linear/linear_solver_factory.hpp"
 #include "io/json.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <string>
 #include <iostream>
@@ -22,6 +29,42 @@
 
 namespace neon::mechanics
 {
+/// Storage of the tangent stiffness matrix selected through the "storage"
+/// option of the linear solver
+enum class matrix_storage {
+    /// Compressed sparse row
+    compressed,
+    /// Block compressed sparse row with a block for each node pair
+    block,
+    /// Upper triangle in compressed sparse row
+    symmetric,
+    /// Element by element evaluation without a global matrix
+    matrix_free
+};
+
+/// Nonlinear solution method selected through the "method" option of the
+/// nonlinear options
+enum class nonlinear_method {
+    /// Full Newton-Raphson with a new tangent in each iteration
+    newton,
+    /// Newton-Raphson reusing the factorised tangent of the first iteration
+    modified_newton,
+    /// Limited memory BFGS updates of the factorised tangent
+    bfgs
+};
+
+/// Starting displacement for the equilibrium iterations of an increment
+/// selected through the "predictor" option of the nonlinear options.  The
+/// value is the order of the extrapolation from the converged increments.
+enum class displacement_predictor {
+    /// Last converged displacement
+    constant,
+    /// Linear extrapolation from the last two converged increments
+    linear,
+    /// Quadratic extrapolation from the last three converged increments
+    quadratic
+};
+
 /// Generic static matrix designed for solid mechanics problems using the
 /// Newton-Raphson method for the solution of nonlinear equations.
 /// This class is responsible for the assembly of the process stiffness matrix,
@@ -31,6 +74,10 @@ class static_matrix
 {
 public:
     using mesh_type = MeshType;
+    /// Block compressed matrix with a block for each node pair
+    using block_matrix = block_sparse_matrix<mesh_type::traits::dofs_per_node>;
+    /// Matrix-free tangent operator
+    using matrix_free_type = matrix_free_operator<mesh_type>;
 
 public:
     explicit static_matrix(mesh_type& mesh, json const& simulation);
@@ -48,14 +95,54 @@ protected:
     /// Assembles the material and geometric stiffness matrices
     void assemble_stiffness();
 
+    /// Assembles the stiffness matrix and gathers the internal force vector
+    /// in a single pass over the elements \sa assemble_stiffness
+    /// \sa compute_internal_force
+    void assemble_stiffness_and_internal_force();
+
+    /// Collect the degrees of freedom of the active Dirichlet boundaries and
+    /// recompute the constraint positions in the stiffness matrix when the
+    /// constrained degrees of freedom change
+    void update_constraints();
+
     /// Apply dirichlet conditions to the system defined by A, x, and b.
     /// This method sets the incremental displacements to zero for the given
     /// load increment such that incremental displacements are zero
-    void enforce_dirichlet_conditions(sparse_matrix& A, vector& b) const;
+    void enforce_dirichlet_conditions(matrix_free_type& A, vector& b) const;
+
+    /// Solve for the incremental displacement with the constrained degrees
+    /// of freedom removed from the system
+    void solve_reduced_system();
+
+    /// Solve for the incremental displacement with the assembled tangent
+    void solve_newton_step();
+
+    /// Solve for the incremental displacement with the tangent factorised in
+    /// an earlier iteration and the BFGS updates when enabled
+    void solve_quasi_newton_step();
+
+    /// Set the relative tolerance of the iterative linear solver from the
+    /// reduction of the residual norm (Eisenstat-Walker forcing term)
+    void update_forcing_term(int const current_iteration, double const last_residual_norm);
+
+    /// Scale the incremental displacement when the full step overshoots the
+    /// equilibrium along its direction, using only residual evaluations
+    void perform_line_search();
 
     /// Move the nodes on the mesh for the Dirichlet boundary
     void apply_displacement_boundaries();
 
+    /// Set the displacement at the start of an increment by extrapolating
+    /// the converged increments and update the internal variables.  The last
+    /// converged displacement is used when the predicted state is not valid.
+    void predict_displacement();
+
+    /// Store the converged displacement for the predictor
+    void save_converged_displacement();
+
+    /// Compute the sparsity pattern and the scatter maps for the storage
+    void allocate_stiffness();
+
     /// Equilibrium iteration convergence criteria
     bool is_iteration_converged() const;
 
@@ -76,6 +163,8 @@ protected:
     bool is_sparsity_computed{false};
     /// Flag for norm computation
     bool use_relative_norm{true};
+    /// Remove the constrained degrees of freedom from the linear system
+    bool use_elimination{false};
 
     double residual_tolerance{1.0e-3};
     double displacement_tolerance{1.0e-3};
@@ -88,8 +177,57 @@ protected:
     /// Maximum number of Newton Raphson iterations before cutback
     int maximum_iterations = 10;
 
-    /// Tangent sparse stiffness matrix
+    /// Nonlinear solution method
+    nonlinear_method method{nonlinear_method::newton};
+    /// Largest ratio of successive residual norms before the tangent is
+    /// updated for the modified Newton and BFGS methods
+    double tangent_update_ratio{0.5};
+    /// Updates of the factorised tangent for the BFGS method
+    limited_memory_bfgs bfgs;
+
+    /// Flag to perform a line search along the incremental displacement
+    bool use_line_search{false};
+    /// Ratio of the energy slope at the step length to the initial slope
+    /// that is accepted by the line search
+    double line_search_tolerance{0.5};
+    /// Maximum number of residual evaluations in the line search
+    int line_search_iterations = 5;
+
+    /// Flag to solve the linear systems inexactly with an iterative solver
+    bool use_inexact_newton{false};
+    /// Upper bound of the relative tolerance of the linear solver
+    double maximum_forcing_term{0.9};
+    /// Relative tolerance of the linear solver in the last iteration
+    double forcing_term{0.0};
+
+    /// Starting displacement for the equilibrium iterations
+    displacement_predictor predictor{displacement_predictor::constant};
+    /// Converged displacements with the most recent last for the predictor
+    std::deque<vector> converged_displacements;
+    /// Step time of each converged displacement
+    std::deque<double> converged_times;
+
+    /// Element colouring for each submesh for conflict free assembly
+    std::vector<element_colouring> colourings;
+    /// Element colouring for each nonfollower boundary mesh
+    std::vector<element_colouring> boundary_colourings;
+    /// Location of each element matrix entry in the coefficients of Kt
+    std::vector<indices> scatter_maps;
+
+    /// Storage of the tangent stiffness matrix
+    matrix_storage storage{matrix_storage::compressed};
+
+    /// Coefficient positions of the Dirichlet constrained degrees of freedom
+    constraint_map constraints;
+
+    /// Tangent sparse stiffness matrix (upper triangle for symmetric storage)
     sparse_matrix Kt;
+    /// Tangent block sparse stiffness matrix when using block storage
+    block_matrix Kt_block;
+    /// Tangent stiffness operator when using matrix-free storage
+    matrix_free_type Kt_operator;
+    /// Tangent stiffness matrix without the constrained degrees of freedom
+    sparse_matrix Kt_reduced;
     /// Internal force vector
     vector f_int;
     /// External force vector
@@ -102,6 +240,10 @@ protected:
     vector delta_d;
     /// Minus residual vector
     vector minus_residual;
+    /// Minus residual and incremental displacement of the reduced system
+    vector minus_residual_reduced, delta_d_reduced;
+    /// Minus residual from the last iteration for the BFGS updates
+    vector minus_residual_old;
 
     std::unique_ptr<linear_solver> solver;
 };
@@ -110,6 +252,7 @@ template <class MeshType>
 static_matrix<MeshType>::static_matrix(mesh_type& mesh, json const& simulation)
     : mesh(mesh),
       adaptive_load(simulation["time"], mesh.time_history()),
+      Kt_operator(mesh, colourings),
       solver(make_linear_solver(simulation["linear_solver"], mesh.is_symmetric()))
 {
     auto const& nonlinear_options = simulation["nonlinear_options"];
@@ -131,11 +274,178 @@ static_matrix<MeshType>::static_matrix(mesh_type& mesh, json const& simulation)
         use_relative_norm = false;
     }
 
+    auto const& linear_solver_options = simulation["linear_solver"];
+
+    if (linear_solver_options.find("storage") != end(linear_solver_options))
+    {
+        std::string const& storage_name = linear_solver_options["storage"];
+
+        if (storage_name == "compressed")
+        {
+            storage = matrix_storage::compressed;
+        }
+        else if (storage_name == "block")
+        {
+            storage = matrix_storage::block;
+        }
+        else if (storage_name == "symmetric")
+        {
+            if (!mesh.is_symmetric())
+            {
+                throw std::domain_error("\"symmetric\" storage requires symmetric constitutive "
+                                        "models");
+            }
+            storage = matrix_storage::symmetric;
+        }
+        else if (storage_name == "matrix_free")
+        {
+            if (linear_solver_options["type"] != "iterative" || !mesh.is_symmetric())
+            {
+                throw std::domain_error("\"matrix_free\" storage requires an \"iterative\" "
+                                        "solver and symmetric constitutive models");
+            }
+            storage = matrix_storage::matrix_free;
+        }
+        else
+        {
+            throw std::domain_error("\"storage\" in linear_solver must be \"compressed\", "
+                                    "\"block\", \"symmetric\" or \"matrix_free\"");
+        }
+    }
+
+    if (linear_solver_options.find("dirichlet") != end(linear_solver_options))
+    {
+        std::string const& dirichlet_name = linear_solver_options["dirichlet"];
+
+        if (dirichlet_name == "eliminated")
+        {
+            if (storage != matrix_storage::compressed && storage != matrix_storage::symmetric)
+            {
+                throw std::domain_error("\"eliminated\" Dirichlet conditions require "
+                                        "\"compressed\" or \"symmetric\" storage");
+            }
+            use_elimination = true;
+        }
+        else if (dirichlet_name != "masked")
+        {
+            throw std::domain_error("\"dirichlet\" in linear_solver must be \"masked\" or "
+                                    "\"eliminated\"");
+        }
+    }
+
+    if (nonlinear_options.find("method") != end(nonlinear_options))
+    {
+        std::string const& method_name = nonlinear_options["method"];
+
+        if (method_name == "newton")
+        {
+            method = nonlinear_method::newton;
+        }
+        else if (method_name == "modified_newton")
+        {
+            method = nonlinear_method::modified_newton;
+        }
+        else if (method_name == "bfgs")
+        {
+            method = nonlinear_method::bfgs;
+        }
+        else
+        {
+            throw std::domain_error("\"method\" in nonlinear_options must be \"newton\", "
+                                    "\"modified_newton\" or \"bfgs\"");
+        }
+
+        if (method != nonlinear_method::newton)
+        {
+            if (storage != matrix_storage::compressed && storage != matrix_storage::symmetric)
+            {
+                throw std::domain_error("\"" + method_name
+                                        + "\" requires \"compressed\" or \"symmetric\" storage");
+            }
+            if (!solver->is_factorisation_reusable())
+            {
+                throw std::domain_error("\"" + method_name
+                                        + "\" requires a linear solver that reuses the "
+                                          "factorisation");
+            }
+        }
+    }
+    if (nonlinear_options.find("tangent_update_ratio") != end(nonlinear_options))
+    {
+        tangent_update_ratio = nonlinear_options["tangent_update_ratio"];
+    }
+    if (nonlinear_options.find("bfgs_updates") != end(nonlinear_options))
+    {
+        bfgs = limited_memory_bfgs(nonlinear_options["bfgs_updates"].get<std::int32_t>());
+    }
+    if (nonlinear_options.find("line_search") != end(nonlinear_options))
+    {
+        use_line_search = nonlinear_options["line_search"];
+    }
+    if (nonlinear_options.find("line_search_tolerance") != end(nonlinear_options))
+    {
+        line_search_tolerance = nonlinear_options["line_search_tolerance"];
+    }
+    if (nonlinear_options.find("line_search_iterations") != end(nonlinear_options))
+    {
+        line_search_iterations = nonlinear_options["line_search_iterations"];
+    }
+    if (nonlinear_options.find("inexact_newton") != end(nonlinear_options))
+    {
+        use_inexact_newton = nonlinear_options["inexact_newton"];
+
+        if (use_inexact_newton
+            && (linear_solver_options["type"] != "iterative"
+                || (linear_solver_options.find("device") != end(linear_solver_options)
+                    && linear_solver_options["device"] != "cpu")))
+        {
+            throw std::domain_error("\"inexact_newton\" requires an \"iterative\" linear solver "
+                                    "on the \"cpu\" device");
+        }
+    }
+    if (nonlinear_options.find("maximum_forcing_term") != end(nonlinear_options))
+    {
+        maximum_forcing_term = nonlinear_options["maximum_forcing_term"];
+
+        if (maximum_forcing_term <= 0.0 || maximum_forcing_term >= 1.0)
+        {
+            throw std::domain_error("\"maximum_forcing_term\" must be between zero and one");
+        }
+    }
+    if (nonlinear_options.find("predictor") != end(nonlinear_options))
+    {
+        std::string const& predictor_name = nonlinear_options["predictor"];
+
+        if (predictor_name == "constant")
+        {
+            predictor = displacement_predictor::constant;
+        }
+        else if (predictor_name == "linear")
+        {
+            predictor = displacement_predictor::linear;
+        }
+        else if (predictor_name == "quadratic")
+        {
+            predictor = displacement_predictor::quadratic;
+        }
+        else
+        {
+            throw std::domain_error("\"predictor\" in nonlinear_options must be \"constant\", "
+                                    "\"linear\" or \"quadratic\"");
+        }
+    }
+
     residual_tolerance = nonlinear_options["residual_tolerance"];
     displacement_tolerance = nonlinear_options["displacement_tolerance"];
 
     f_int = f_ext = displacement = displacement_old = delta_d = vector::Zero(mesh.active_dofs());
 
+    colourings = colour_elements(mesh);
+    boundary_colourings = colour_boundary_elements(mesh);
+
+    // The undeformed state is the first converged state
+    save_converged_displacement();
+
     // Perform Newton-Raphson iterations
     std::cout << "\n"
               << std::string(4, ' ') << "Non-linear equation system has " << mesh.active_dofs()
@@ -145,44 +455,37 @@ static_matrix<MeshType>::static_matrix(mesh_type& mesh, json const& simulation)
 template <class MeshType>
 void static_matrix<MeshType>::solve()
 {
-    try
-    {
-        // Initialise the mesh with zero displacements
-        mesh.update_internal_variables(displacement);
-        mesh.update_internal_forces(f_int);
+    // Initialise the mesh with zero displacements
+    mesh.update_internal_variables(displacement);
+    mesh.update_internal_forces(f_int);
 
-        mesh.write(adaptive_load.step(), adaptive_load.time());
+    mesh.write(adaptive_load.step(), adaptive_load.time());
 
-        while (!adaptive_load.is_fully_applied())
-        {
-            std::cout << "\n"
-                      << std::string(4, ' ') << termcolor::magenta << termcolor::bold
-                      << "Performing equilibrium iterations for time " << adaptive_load.step_time()
-                      << termcolor::reset << std::endl;
+    while (!adaptive_load.is_fully_applied())
+    {
+        std::cout << "\n"
+                  << std::string(4, ' ') << termcolor::magenta << termcolor::bold
+                  << "Performing equilibrium iterations for time " << adaptive_load.step_time()
+                  << termcolor::reset << std::endl;
 
+        try
+        {
             compute_external_force();
 
             perform_equilibrium_iterations();
         }
-    }
-    catch (computational_error& comp_error)
-    {
-        // A numerical error has been reported that is able to be recovered
-        // by resetting the state
-        std::cout << std::endl
-                  << std::string(6, ' ') << termcolor::bold << termcolor::yellow
-                  << comp_error.what() << termcolor::reset << std::endl;
-
-        adaptive_load.update_convergence_state(false);
-        mesh.save_internal_variables(false);
-
-        displacement = displacement_old;
-
-        this->solve();
-    }
-    catch (...)
-    {
-        throw;
+        catch (computational_error& comp_error)
+        {
+            // A numerical error has been reported that is able to be recovered
+            // by resetting the state to the last converged increment, where the
+            // displacement is reset at the start of the next attempt
+            std::cout << std::endl
+                      << std::string(6, ' ') << termcolor::bold << termcolor::yellow
+                      << comp_error.what() << termcolor::reset << std::endl;
+
+            adaptive_load.update_convergence_state(false);
+            mesh.save_internal_variables(false);
+        }
     }
 }
 
@@ -191,14 +494,16 @@ void static_matrix<MeshType>::compute_internal_force()
 {
     f_int.setZero();
 
-    for (auto const& submesh : mesh.meshes())
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
     {
-        for (std::int64_t element{0}; element < submesh.elements(); ++element)
-        {
-            auto const dof_indices = submesh.local_dof_view(element);
+        auto const& submesh = mesh.meshes()[index];
 
-            f_int(dof_indices) += submesh.internal_force(element);
-        }
+        colourings[index].parallel_for_batch(submesh.batch_size(), [&](auto const* elements,
+                                                                        auto const count) {
+            submesh.internal_force(elements, count, [&](auto const element, auto const& f_e) {
+                f_int(submesh.local_dof_view(element)) += f_e;
+            });
+        });
     }
 }
 
@@ -211,20 +516,24 @@ void static_matrix<MeshType>::compute_external_force()
 
     f_ext.setZero();
 
+    // Boundary colourings follow the order of the boundary meshes
+    auto colouring = begin(boundary_colourings);
+
     for (auto const& [name, boundaries] : mesh.nonfollower_boundaries())
     {
         for (auto const& boundary : boundaries.natural_interface())
         {
             std::visit(
                 [&](auto const& boundary_mesh) {
-                    for (std::int64_t element{0}; element < boundary_mesh.elements(); ++element)
-                    {
+                    colouring->parallel_for([&](auto const element) {
                         auto const [dofs, fe_ext] = boundary_mesh.external_force(element, step_time);
 
                         f_ext(dofs) += fe_ext;
-                    }
+                    });
                 },
                 boundary);
+
+            ++colouring;
         }
         for (auto const& boundary : boundaries.nodal_interface())
         {
@@ -234,6 +543,7 @@ void static_matrix<MeshType>::compute_external_force()
             }
         }
     }
+
     auto const end = std::chrono::steady_clock::now();
     std::chrono::duration<double> elapsed_seconds = end - start;
     std::cout << std::string(6, ' ') << "External forces assembly took " << elapsed_seconds.count()
@@ -241,32 +551,95 @@ void static_matrix<MeshType>::compute_external_force()
 }
 
 template <class MeshType>
-void static_matrix<MeshType>::assemble_stiffness()
+void static_matrix<MeshType>::allocate_stiffness()
 {
     if (!is_sparsity_computed)
     {
-        compute_sparsity_pattern(Kt, mesh);
+        switch (storage)
+        {
+            case matrix_storage::compressed:
+                compute_sparsity_pattern(Kt, mesh);
+                scatter_maps = compute_scatter_map(Kt, mesh);
+                break;
+            case matrix_storage::block:
+                compute_sparsity_pattern(Kt_block, mesh);
+                scatter_maps = compute_scatter_map(Kt_block, mesh);
+                break;
+            case matrix_storage::symmetric:
+                compute_upper_sparsity_pattern(Kt, mesh);
+                scatter_maps = compute_upper_scatter_map(Kt, mesh);
+                break;
+            case matrix_storage::matrix_free:
+                break;
+        }
         is_sparsity_computed = true;
     }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::assemble_stiffness()
+{
+    allocate_stiffness();
 
     auto const start = std::chrono::steady_clock::now();
 
-    Kt.coeffs() = 0.0;
+    auto const assemble = [&](auto& A) {
+        A.coeffs() = 0.0;
 
-    for (auto const& submesh : mesh.meshes())
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            // Elements of the same colour do not share degrees of freedom
+            colourings[index].parallel_for_batch(submesh.batch_size(), [&](auto const* elements,
+                                                                            auto const count) {
+                submesh.tangent_stiffness(elements,
+                                          count,
+                                          false,
+                                          [&](auto const element, auto const& k_e) {
+                                              scatter_add(A,
+                                                          scatter_maps[index].col(element),
+                                                          k_e);
+                                          });
+            });
+        }
+    };
+
+    switch (storage)
     {
-        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
-            auto const dof_indices = submesh.local_dof_view(element);
-            auto const& ke = submesh.tangent_stiffness(element);
+        case matrix_storage::compressed:
+            assemble(Kt);
+            break;
+        case matrix_storage::block:
+            assemble(Kt_block);
+            break;
+        case matrix_storage::symmetric:
+        {
+            Kt.coeffs() = 0.0;
 
-            for (std::int64_t b{0}; b < dof_indices.size(); b++)
+            for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
             {
-                for (std::int64_t a{0}; a < dof_indices.size(); a++)
-                {
-                    Kt.add_to(dof_indices(a), dof_indices(b), ke(a, b));
-                }
+                auto const& submesh = mesh.meshes()[index];
+
+                colourings[index].parallel_for_batch(submesh.batch_size(), [&](auto const* elements,
+                                                                                auto const count) {
+                    submesh.tangent_stiffness(elements,
+                                              count,
+                                              true,
+                                              [&](auto const element, auto const& k_e) {
+                                                  auto const offsets = scatter_maps[index].col(
+                                                      element);
+
+                                                  scatter_add_upper(Kt, offsets, k_e);
+                                              });
+                });
             }
-        });
+            break;
+        }
+        case matrix_storage::matrix_free:
+            // Only the diagonal is required for the preconditioner
+            Kt_operator.update();
+            break;
     }
 
     auto const end = std::chrono::steady_clock::now();
@@ -277,8 +650,70 @@ void static_matrix<MeshType>::assemble_stiffness()
 }
 
 template <class MeshType>
-void static_matrix<MeshType>::enforce_dirichlet_conditions(sparse_matrix& A, vector& b) const
+void static_matrix<MeshType>::assemble_stiffness_and_internal_force()
+{
+    allocate_stiffness();
+
+    auto const start = std::chrono::steady_clock::now();
+
+    if (storage == matrix_storage::block)
+    {
+        Kt_block.coeffs() = 0.0;
+    }
+    else
+    {
+        Kt.coeffs() = 0.0;
+    }
+
+    f_int.setZero();
+
+    bool const upper_only = storage == matrix_storage::symmetric;
+
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+    {
+        auto const& submesh = mesh.meshes()[index];
+
+        // Elements of the same colour do not share degrees of freedom
+        colourings[index].parallel_for_batch(submesh.batch_size(), [&](auto const* elements,
+                                                                        auto const count) {
+            submesh.tangent_stiffness_and_internal_force(
+                elements,
+                count,
+                upper_only,
+                [&](auto const element, auto const& k_e, auto const& f_e) {
+                    auto const offsets = scatter_maps[index].col(element);
+
+                    switch (storage)
+                    {
+                        case matrix_storage::compressed:
+                            scatter_add(Kt, offsets, k_e);
+                            break;
+                        case matrix_storage::block:
+                            scatter_add(Kt_block, offsets, k_e);
+                            break;
+                        case matrix_storage::symmetric:
+                            scatter_add_upper(Kt, offsets, k_e);
+                            break;
+                        case matrix_storage::matrix_free:
+                            break;
+                    }
+                    f_int(submesh.local_dof_view(element)) += f_e;
+                });
+        });
+    }
+
+    auto const end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> const elapsed_seconds = end - start;
+
+    std::cout << std::string(6, ' ') << "Tangent stiffness and internal forces assembly took "
+              << elapsed_seconds.count() << "s\n";
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::update_constraints()
 {
+    std::vector<std::int64_t> fixed_dofs;
+
     for (auto const& [name, boundaries] : mesh.dirichlet_boundaries())
     {
         for (auto const& boundary : boundaries)
@@ -287,36 +722,205 @@ void static_matrix<MeshType>::enforce_dirichlet_conditions(sparse_matrix& A, vec
             {
                 continue;
             }
+            auto const& dofs = boundary.dof_view();
+
+            fixed_dofs.insert(end(fixed_dofs), begin(dofs), end(dofs));
+        }
+    }
 
-            for (auto const& fixed_dof : boundary.dof_view())
+    if (!constraints.update(std::move(fixed_dofs), mesh.active_dofs())) return;
+
+    switch (storage)
+    {
+        case matrix_storage::compressed:
+        case matrix_storage::symmetric:
+            if (use_elimination)
+            {
+                constraints.compute_reduction(Kt, Kt_reduced);
+                solver->update_sparsity_pattern();
+            }
+            else
+            {
+                constraints.compute_positions(Kt);
+            }
+            break;
+        case matrix_storage::block:
+            constraints.compute_positions(Kt_block);
+            break;
+        case matrix_storage::matrix_free:
+            break;
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::enforce_dirichlet_conditions(matrix_free_type& A, vector& b) const
+{
+    for (auto const fixed_dof : constraints.dofs())
+    {
+        b(fixed_dof) = 0.0;
+
+        A.constrain(fixed_dof);
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::solve_reduced_system()
+{
+    constraints.reduce(Kt, Kt_reduced);
+    constraints.reduce(minus_residual, minus_residual_reduced);
+
+    solver->solve(Kt_reduced, delta_d_reduced, minus_residual_reduced);
+
+    constraints.expand(delta_d_reduced, delta_d);
+
+    // The residual at the constrained degrees of freedom is not in equilibrium
+    constraints.apply(minus_residual);
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::solve_newton_step()
+{
+    switch (storage)
+    {
+        case matrix_storage::compressed:
+        case matrix_storage::symmetric:
+            if (use_elimination)
             {
-                auto const diagonal_entry = A.coeff(fixed_dof, fixed_dof);
-
-                b(fixed_dof) = 0.0;
-
-                std::vector<std::int32_t> non_zero_visitor;
-
-                // Zero the rows and columns
-                for (sparse_matrix::InnerIterator it(A, fixed_dof); it; ++it)
-                {
-                    // Set the value of the col or row resp. to zero
-                    it.valueRef() = 0.0;
-                    non_zero_visitor.push_back(A.IsRowMajor ? it.col() : it.row());
-                }
-
-                // Zero the row or col respectively
-                for (auto const& non_zero : non_zero_visitor)
-                {
-                    const auto row = A.IsRowMajor ? non_zero : fixed_dof;
-                    const auto col = A.IsRowMajor ? fixed_dof : non_zero;
-
-                    A.coeffRef(row, col) = 0.0;
-                }
-                // Reset the diagonal to the same value to preserve conditioning
-                A.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
+                solve_reduced_system();
             }
+            else
+            {
+                constraints.apply(Kt, minus_residual);
+                solver->solve(Kt, delta_d, minus_residual);
+            }
+            break;
+        case matrix_storage::block:
+            constraints.apply(Kt_block, minus_residual);
+            solver->solve(Kt_block, delta_d, minus_residual);
+            break;
+        case matrix_storage::matrix_free:
+            enforce_dirichlet_conditions(Kt_operator, minus_residual);
+            solver->solve(Kt_operator, delta_d, minus_residual);
+            break;
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::solve_quasi_newton_step()
+{
+    auto const factorised_solve = [this](vector& x, vector const& b) {
+        if (use_elimination)
+        {
+            constraints.reduce(b, minus_residual_reduced);
+            solver->solve_with_factorisation(delta_d_reduced, minus_residual_reduced);
+            constraints.expand(delta_d_reduced, x);
         }
+        else
+        {
+            solver->solve_with_factorisation(x, b);
+        }
+    };
+
+    if (method == nonlinear_method::bfgs)
+    {
+        bfgs.solve(delta_d, minus_residual, factorised_solve);
+    }
+    else
+    {
+        factorised_solve(delta_d, minus_residual);
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::update_forcing_term(int const current_iteration,
+                                                  double const last_residual_norm)
+{
+    // Choice 2 of Eisenstat and Walker (1996) Choosing the forcing terms in an
+    // inexact Newton method, SIAM Journal on Scientific Computing
+    auto constexpr gamma{0.9};
+    auto constexpr initial_forcing_term{0.5};
+
+    if (current_iteration == 0 || is_approx(last_residual_norm, 0.0))
+    {
+        forcing_term = std::min(initial_forcing_term, maximum_forcing_term);
     }
+    else
+    {
+        // The residual norm is measured without the constrained entries
+        constraints.apply(minus_residual);
+
+        double const residual_ratio = minus_residual.norm() / last_residual_norm;
+
+        // Prevent a sudden decrease from a large forcing term
+        double const safeguard = gamma * forcing_term * forcing_term;
+
+        forcing_term = gamma * residual_ratio * residual_ratio;
+
+        if (safeguard > 0.1) forcing_term = std::max(forcing_term, safeguard);
+
+        forcing_term = std::min(forcing_term, maximum_forcing_term);
+    }
+    solver->set_forcing_term(forcing_term);
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::perform_line_search()
+{
+    // Slope of the potential energy along the incremental displacement
+    double const initial_slope = delta_d.dot(minus_residual);
+
+    if (initial_slope <= 0.0) return;
+
+    auto const slope_at_step = [&]() {
+        compute_internal_force();
+
+        vector residual = f_ext - f_int;
+
+        constraints.apply(residual);
+
+        return delta_d.dot(residual);
+    };
+
+    double step_length{1.0};
+
+    double slope = slope_at_step();
+
+    auto evaluations{1};
+
+    // Backtrack only when the energy increases along the step
+    while (slope < -line_search_tolerance * initial_slope && evaluations < line_search_iterations)
+    {
+        // Root of the linear interpolation of the slope with safeguards
+        double const next_step_length = std::clamp(step_length * initial_slope
+                                                       / (initial_slope - slope),
+                                                   0.1 * step_length,
+                                                   0.9 * step_length);
+
+        displacement += (next_step_length - step_length) * delta_d;
+
+        step_length = next_step_length;
+
+        // Remove the history accumulated by the rejected trial
+        mesh.restore_internal_variables();
+
+        mesh.update_stress(displacement);
+
+        slope = slope_at_step();
+
+        ++evaluations;
+    }
+
+    if (step_length < 1.0)
+    {
+        delta_d *= step_length;
+
+        mesh.restore_internal_variables();
+
+        mesh.update_internal_variables(displacement, 0.0);
+    }
+
+    std::cout << std::string(6, ' ') << "Line search step length " << step_length << " from "
+              << evaluations << " residual evaluations\n";
 }
 
 template <class MeshType>
@@ -336,20 +940,108 @@ void static_matrix<MeshType>::apply_displacement_boundaries()
             auto const delta_u = boundary.value_view(adaptive_load.step_time())
                                  - boundary.value_view(adaptive_load.last_step_time());
 
+            // Remove any change already made by the predictor
             for (auto const& dof : boundary.dof_view())
             {
-                prescribed_increment.coeffRef(dof) = delta_u;
+                prescribed_increment.coeffRef(dof) = delta_u
+                                                     - (displacement(dof) - displacement_old(dof));
             }
         }
     }
 
     // A sparse matrix - sparse vector multiplication is more efficient for a
     // relatively small vector size with the exception of allocation
-    minus_residual -= Kt * prescribed_increment;
+    switch (storage)
+    {
+        case matrix_storage::compressed:
+            minus_residual -= Kt * prescribed_increment;
+            break;
+        case matrix_storage::block:
+            minus_residual -= Kt_block * vector(prescribed_increment);
+            break;
+        case matrix_storage::symmetric:
+            minus_residual -= Kt.selfadjointView<Eigen::Upper>() * vector(prescribed_increment);
+            break;
+        case matrix_storage::matrix_free:
+            minus_residual -= Kt_operator * vector(prescribed_increment);
+            break;
+    }
 
     displacement += prescribed_increment;
 }
 
+template <class MeshType>
+void static_matrix<MeshType>::predict_displacement()
+{
+    displacement = displacement_old;
+
+    auto const points = std::min(static_cast<std::size_t>(predictor) + 1,
+                                 converged_displacements.size());
+
+    if (points < 2)
+    {
+        mesh.update_internal_variables(displacement, adaptive_load.increment());
+        return;
+    }
+
+    auto const first = converged_times.size() - points;
+
+    // Lagrange extrapolation through the last converged increments
+    displacement.setZero();
+
+    for (auto i = first; i < converged_times.size(); ++i)
+    {
+        double weight{1.0};
+
+        for (auto j = first; j < converged_times.size(); ++j)
+        {
+            if (i == j) continue;
+
+            weight *= (adaptive_load.step_time() - converged_times[j])
+                      / (converged_times[i] - converged_times[j]);
+        }
+        displacement += weight * converged_displacements[i];
+    }
+
+    try
+    {
+        mesh.update_internal_variables(displacement, adaptive_load.increment());
+    }
+    catch (computational_error& comp_error)
+    {
+        std::cout << std::string(6, ' ') << termcolor::yellow << "Predicted displacement rejected: "
+                  << comp_error.what() << termcolor::reset << "\n";
+
+        displacement = displacement_old;
+
+        // Discard the history of the submeshes updated before the failure
+        mesh.save_internal_variables(false);
+
+        mesh.update_internal_variables(displacement, adaptive_load.increment());
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::save_converged_displacement()
+{
+    if (predictor == displacement_predictor::constant) return;
+
+    if (converged_displacements.size() > static_cast<std::size_t>(predictor))
+    {
+        // Reuse the storage of the oldest displacement
+        converged_displacements.push_back(std::move(converged_displacements.front()));
+        converged_displacements.pop_front();
+        converged_times.pop_front();
+
+        converged_displacements.back() = displacement_old;
+    }
+    else
+    {
+        converged_displacements.push_back(displacement_old);
+    }
+    converged_times.push_back(adaptive_load.last_step_time());
+}
+
 template <class MeshType>
 bool static_matrix<MeshType>::is_iteration_converged() const
 {
@@ -402,12 +1094,15 @@ void static_matrix<MeshType>::update_relative_norms()
 template <class MeshType>
 void static_matrix<MeshType>::perform_equilibrium_iterations()
 {
-    displacement = displacement_old;
+    predict_displacement();
 
-    mesh.update_internal_variables(displacement, adaptive_load.increment());
-
-    // Full Newton-Raphson iteration to solve nonlinear equations
+    // Newton-Raphson iterations to solve nonlinear equations, where the
+    // tangent is always updated at the start of an increment
     auto current_iteration{0};
+
+    // Residual norm of the last iteration to detect a degraded convergence rate
+    double last_residual_norm{0.0};
+
     while (current_iteration < maximum_iterations)
     {
         auto const start = std::chrono::steady_clock::now();
@@ -415,9 +1110,22 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
         std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold
                   << "Newton-Raphson iteration " << current_iteration << termcolor::reset << "\n";
 
-        assemble_stiffness();
+        bool is_tangent_updated = current_iteration == 0 || method == nonlinear_method::newton;
 
-        compute_internal_force();
+        if (storage == matrix_storage::matrix_free)
+        {
+            assemble_stiffness();
+
+            compute_internal_force();
+        }
+        else if (is_tangent_updated)
+        {
+            assemble_stiffness_and_internal_force();
+        }
+        else
+        {
+            compute_internal_force();
+        }
 
         minus_residual = f_ext - f_int;
 
@@ -427,14 +1135,61 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
             norm_initial_residual = minus_residual.norm();
         }
 
-        enforce_dirichlet_conditions(Kt, minus_residual);
+        update_constraints();
+
+        if (!is_tangent_updated)
+        {
+            constraints.apply(minus_residual);
+
+            if (method == nonlinear_method::bfgs)
+            {
+                bfgs.push_back(delta_d, minus_residual_old, minus_residual);
+            }
+
+            // Fall back to a full Newton step when the convergence rate degrades
+            if (minus_residual.norm() > tangent_update_ratio * last_residual_norm)
+            {
+                std::cout << std::string(6, ' ') << "Convergence rate degraded, updating tangent\n";
 
-        solver->solve(Kt, delta_d, minus_residual);
+                assemble_stiffness();
+
+                is_tangent_updated = true;
+            }
+        }
+
+        if (use_inexact_newton) update_forcing_term(current_iteration, last_residual_norm);
+
+        if (is_tangent_updated)
+        {
+            bfgs.clear();
+
+            solve_newton_step();
+        }
+        else
+        {
+            std::cout << std::string(6, ' ') << "Reusing tangent factorisation";
+            if (method == nonlinear_method::bfgs)
+            {
+                std::cout << " with " << bfgs.size() << " BFGS updates";
+            }
+            std::cout << "\n";
+
+            solve_quasi_newton_step();
+        }
+
+        last_residual_norm = minus_residual.norm();
+
+        if (method == nonlinear_method::bfgs) minus_residual_old = minus_residual;
 
         displacement += delta_d;
 
+        // The line search trials accumulate the history from this state
+        if (use_line_search) mesh.checkpoint_internal_variables();
+
         mesh.update_internal_variables(displacement, 0.0);
 
+        if (use_line_search) perform_line_search();
+
         update_relative_norms();
 
         print_convergence_progress();
@@ -455,11 +1210,22 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
 
     if (current_iteration != maximum_iterations)
     {
-        displacement_old = displacement;
+        // The displacement is overwritten at the start of the next increment
+        displacement_old.swap(displacement);
+
+        adaptive_load.update_convergence_state(current_iteration != maximum_iterations,
+                                               current_iteration + 1);
+        auto const commit_start = std::chrono::steady_clock::now();
 
-        adaptive_load.update_convergence_state(current_iteration != maximum_iterations);
         mesh.save_internal_variables(current_iteration != maximum_iterations);
 
+        auto const commit_end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> const commit_seconds = commit_end - commit_start;
+        std::cout << std::string(6, ' ') << "Internal variable commit took "
+                  << commit_seconds.count() << "s\n";
+
+        save_converged_displacement();
+
         mesh.update_internal_forces(f_int);
 
         mesh.write(adaptive_load.step(), adaptive_load.time());
@@ -3,47 +3,459 @@
 
 /// @file
 
-#include "numeric/doublet.hpp"
+#include "graph/node_to_element.hpp"
+#include "numeric/block_sparse_matrix.hpp"
+#include "numeric/index_types.hpp"
 
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace neon
 {
+namespace detail
+{
+/// \return the number of degrees of freedom for each node in \p mesh or zero
+/// if the mesh contains no elements
+template <typename mesh_type>
+[[nodiscard]] auto dofs_per_node(mesh_type const& mesh) -> std::int64_t
+{
+    for (auto const& submesh : mesh.meshes())
+    {
+        if (submesh.elements() > 0)
+        {
+            return submesh.local_dof_view(0).size() / submesh.nodes_per_element();
+        }
+    }
+    return 0;
+}
+
+/// Compute in parallel the sorted list of nodes connected to each node
+/// through the elements of \p mesh, including the node itself
+template <typename integer_type, typename mesh_type>
+[[nodiscard]] auto node_graph(mesh_type const& mesh, std::int64_t const nodes)
+    -> std::vector<std::vector<integer_type>>
+{
+    std::vector<node_to_element> node_elements;
+    node_elements.reserve(mesh.meshes().size());
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        node_elements.emplace_back(submesh.all_node_indices(), nodes);
+    }
+
+    std::vector<std::vector<integer_type>> graph(nodes);
+
+    tbb::parallel_for(std::int64_t{0}, nodes, [&](auto const node) {
+        auto& neighbours = graph[node];
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& node_indices = mesh.meshes()[index].all_node_indices();
+
+            for (auto element = node_elements[index].begin(node);
+                 element != node_elements[index].end(node);
+                 ++element)
+            {
+                for (std::int64_t row{0}; row < node_indices.rows(); ++row)
+                {
+                    neighbours.emplace_back(node_indices(row, *element));
+                }
+            }
+        }
+        std::sort(begin(neighbours), end(neighbours));
+        neighbours.erase(std::unique(begin(neighbours), end(neighbours)), end(neighbours));
+        neighbours.shrink_to_fit();
+    });
+    return graph;
+}
+}
+
 /// Compute the sparsity (nonzero) pattern of a sparse matrix and compress
 /// the resulting data structure.  This function requires that the mesh_type
 /// provide a \p local_dof_view method for each of the submeshes associated
-/// with the \p mesh
+/// with the \p mesh and that the degrees of freedom are numbered node-wise
+/// (\sa dof_allocator).  The pattern is formed from the node connectivity
+/// graph in parallel with each node pair expanded into a dense block, which
+/// avoids storing a list of every element matrix entry.
 /// This results in the non-zero entries in A set to zero.
 template <typename sparse_matrix_type, typename mesh_type>
 void compute_sparsity_pattern(sparse_matrix_type& A, mesh_type const& mesh)
 {
-    using integer_type = typename sparse_matrix_type::Index;
+    using integer_type = typename sparse_matrix_type::StorageIndex;
 
     static_assert(std::is_integral<integer_type>::value, "Index type must be an integer");
 
-    std::vector<doublet<integer_type>> ij;
-    ij.reserve(mesh.active_dofs());
+    std::int64_t const dofs = mesh.active_dofs();
+
+    A.resize(dofs, dofs);
+
+    std::int64_t const dofs_per_node = detail::dofs_per_node(mesh);
+
+    if (dofs_per_node == 0) return;
+
+    std::int64_t const nodes = dofs / dofs_per_node;
+
+    auto const node_graph = detail::node_graph<integer_type>(mesh, nodes);
+
+    // Each row of a node block has the same number of entries
+    auto* const outer_index = A.outerIndexPtr();
+
+    for (std::int64_t node{0}; node < nodes; ++node)
+    {
+        for (std::int64_t p{0}; p < dofs_per_node; ++p)
+        {
+            auto const dof = node * dofs_per_node + p;
+
+            outer_index[dof + 1] = outer_index[dof] + node_graph[node].size() * dofs_per_node;
+        }
+    }
+
+    A.resizeNonZeros(outer_index[dofs]);
+
+    auto* const inner_index = A.innerIndexPtr();
+
+    tbb::parallel_for(std::int64_t{0}, nodes, [&](auto const node) {
+        for (std::int64_t p{0}; p < dofs_per_node; ++p)
+        {
+            auto position = outer_index[node * dofs_per_node + p];
 
-    A.resize(mesh.active_dofs(), mesh.active_dofs());
+            for (auto const neighbour : node_graph[node])
+            {
+                for (std::int64_t q{0}; q < dofs_per_node; ++q)
+                {
+                    inner_index[position++] = neighbour * dofs_per_node + q;
+                }
+            }
+        }
+    });
+
+    A.coeffs() = 0.0;
+}
+
+/// Compute the sparsity pattern of the upper triangle (including the diagonal)
+/// of a symmetric matrix.  Only the coefficients in the upper triangle are
+/// stored, which halves the storage in comparison to \sa compute_sparsity_pattern
+/// for the same mesh.  The coefficients of \p A are set to zero.
+template <typename sparse_matrix_type, typename mesh_type>
+void compute_upper_sparsity_pattern(sparse_matrix_type& A, mesh_type const& mesh)
+{
+    using integer_type = typename sparse_matrix_type::StorageIndex;
+
+    static_assert(std::is_integral<integer_type>::value, "Index type must be an integer");
+    static_assert(sparse_matrix_type::IsRowMajor, "Upper storage requires a row major matrix");
+
+    std::int64_t const dofs = mesh.active_dofs();
+
+    A.resize(dofs, dofs);
+
+    std::int64_t const dofs_per_node = detail::dofs_per_node(mesh);
+
+    if (dofs_per_node == 0) return;
+
+    std::int64_t const nodes = dofs / dofs_per_node;
+
+    auto const node_graph = detail::node_graph<integer_type>(mesh, nodes);
+
+    // Position of the diagonal node in the sorted neighbours for each node
+    std::vector<std::int64_t> diagonal_position(nodes);
+
+    auto* const outer_index = A.outerIndexPtr();
+
+    for (std::int64_t node{0}; node < nodes; ++node)
+    {
+        auto const& neighbours = node_graph[node];
+
+        diagonal_position[node] = std::lower_bound(begin(neighbours), end(neighbours), node)
+                                  - begin(neighbours);
+
+        // Blocks to the right of the diagonal block are stored in full
+        std::int64_t const upper_nodes = neighbours.size() - diagonal_position[node] - 1;
+
+        for (std::int64_t p{0}; p < dofs_per_node; ++p)
+        {
+            auto const dof = node * dofs_per_node + p;
+
+            outer_index[dof + 1] = outer_index[dof] + upper_nodes * dofs_per_node
+                                   + dofs_per_node - p;
+        }
+    }
+
+    A.resizeNonZeros(outer_index[dofs]);
+
+    auto* const inner_index = A.innerIndexPtr();
+
+    tbb::parallel_for(std::int64_t{0}, nodes, [&](auto const node) {
+        auto const& neighbours = node_graph[node];
+
+        for (std::int64_t p{0}; p < dofs_per_node; ++p)
+        {
+            auto position = outer_index[node * dofs_per_node + p];
+
+            for (std::int64_t q{p}; q < dofs_per_node; ++q)
+            {
+                inner_index[position++] = node * dofs_per_node + q;
+            }
+
+            for (auto neighbour = begin(neighbours) + diagonal_position[node] + 1;
+                 neighbour != end(neighbours);
+                 ++neighbour)
+            {
+                for (std::int64_t q{0}; q < dofs_per_node; ++q)
+                {
+                    inner_index[position++] = *neighbour * dofs_per_node + q;
+                }
+            }
+        }
+    });
+
+    A.coeffs() = 0.0;
+}
+
+/// Compute the block sparsity pattern of \p A from the node connectivity
+/// graph of \p mesh, where each block couples two nodes.  The block size
+/// must match the number of degrees of freedom per node.
+template <int BlockSize, typename mesh_type>
+void compute_sparsity_pattern(block_sparse_matrix<BlockSize>& A, mesh_type const& mesh)
+{
+    using integer_type = typename block_sparse_matrix<BlockSize>::index_type;
+
+    auto const dofs_per_node = detail::dofs_per_node(mesh);
+
+    if (dofs_per_node != 0 && dofs_per_node != BlockSize)
+    {
+        throw std::domain_error("Block size does not match the degrees of freedom per node");
+    }
+
+    std::int64_t const nodes = mesh.active_dofs() / BlockSize;
+
+    auto const node_graph = detail::node_graph<integer_type>(mesh, dofs_per_node == 0 ? 0 : nodes);
+
+    std::vector<integer_type> row_offsets(nodes + 1, 0);
+
+    for (std::int64_t node{0}; node < static_cast<std::int64_t>(node_graph.size()); ++node)
+    {
+        row_offsets[node + 1] = row_offsets[node] + node_graph[node].size();
+    }
+
+    std::vector<integer_type> column_indices(row_offsets.back());
+
+    tbb::parallel_for(std::int64_t{0},
+                      static_cast<std::int64_t>(node_graph.size()),
+                      [&](auto const node) {
+                          std::copy(begin(node_graph[node]),
+                                    end(node_graph[node]),
+                                    begin(column_indices) + row_offsets[node]);
+                      });
+
+    A.set_structure(std::move(row_offsets), std::move(column_indices));
+}
+
+/// Compute the scatter map for each submesh in \p mesh.  A scatter map holds
+/// for each element (column) the position of every element matrix coefficient
+/// (row \f$ a n + b \f$ for the local entry \f$ (a, b) \f$ of an \f$ n \times n \f$
+/// element matrix) in the coefficient array of the compressed matrix \p A.
+/// Assembly then reduces to an indexed addition without any searching and
+/// remains valid for as long as the sparsity pattern of \p A is unchanged.
+/// \sa compute_sparsity_pattern
+/// \sa scatter_add
+template <typename sparse_matrix_type, typename mesh_type>
+[[nodiscard]] auto compute_scatter_map(sparse_matrix_type const& A, mesh_type const& mesh)
+    -> std::vector<indices>
+{
+    static_assert(sizeof(typename sparse_matrix_type::StorageIndex) <= sizeof(indices::Scalar),
+                  "Storage index type must fit into the scatter map");
+
+    auto const* const outer_index = A.outerIndexPtr();
+    auto const* const inner_index = A.innerIndexPtr();
+
+    std::vector<indices> scatter_maps;
+    scatter_maps.reserve(mesh.meshes().size());
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        // Every element in a submesh has the same number of degrees of freedom
+        std::int64_t const local_size = submesh.elements() > 0 ? submesh.local_dof_view(0).size()
+                                                               : 0;
+
+        auto& scatter_map = scatter_maps.emplace_back(local_size * local_size, submesh.elements());
+
+        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+            auto const dof_view = submesh.local_dof_view(element);
+
+            for (std::int64_t a{0}; a < local_size; ++a)
+            {
+                for (std::int64_t b{0}; b < local_size; ++b)
+                {
+                    auto const outer = A.IsRowMajor ? dof_view(a) : dof_view(b);
+                    auto const inner = A.IsRowMajor ? dof_view(b) : dof_view(a);
+
+                    auto const location = std::lower_bound(inner_index + outer_index[outer],
+                                                           inner_index + outer_index[outer + 1],
+                                                           inner);
+
+                    scatter_map(a * local_size + b, element) = std::distance(inner_index, location);
+                }
+            }
+        });
+    }
+    return scatter_maps;
+}
+
+/// Add the element matrix \p local_matrix into the coefficients of \p A using
+/// the element column of a scatter map.  Concurrent calls must not share
+/// degrees of freedom, for example through an element colouring.
+/// \sa compute_scatter_map
+template <typename sparse_matrix_type, typename offset_type, typename local_matrix_type>
+void scatter_add(sparse_matrix_type& A, offset_type const& offsets, local_matrix_type const& local_matrix)
+{
+    auto* const values = A.valuePtr();
+
+    auto const local_size = local_matrix.rows();
+
+    for (std::int64_t a{0}; a < local_size; ++a)
+    {
+        for (std::int64_t b{0}; b < local_size; ++b)
+        {
+            values[offsets(a * local_size + b)] += local_matrix(a, b);
+        }
+    }
+}
+
+/// Compute the scatter map for each submesh in \p mesh into the upper
+/// triangular matrix \p A for symmetric element matrices.  Only the upper
+/// triangle of each element matrix is mapped, with the local entries
+/// \f$ (a, b) \f$ for \f$ b \geq a \f$ stored row by row.  Local entries that
+/// fall into the lower triangle of \p A are mapped onto their transposed
+/// position, which holds the same value for a symmetric element matrix.
+/// \sa compute_upper_sparsity_pattern
+/// \sa scatter_add_upper
+template <typename sparse_matrix_type, typename mesh_type>
+[[nodiscard]] auto compute_upper_scatter_map(sparse_matrix_type const& A, mesh_type const& mesh)
+    -> std::vector<indices>
+{
+    static_assert(sparse_matrix_type::IsRowMajor, "Upper storage requires a row major matrix");
+
+    auto const* const outer_index = A.outerIndexPtr();
+    auto const* const inner_index = A.innerIndexPtr();
+
+    std::vector<indices> scatter_maps;
+    scatter_maps.reserve(mesh.meshes().size());
 
     for (auto const& submesh : mesh.meshes())
     {
-        // Loop over the elements and add in the non-zero components
-        for (std::int64_t element{0}; element < submesh.elements(); element++)
+        std::int64_t const local_size = submesh.elements() > 0 ? submesh.local_dof_view(0).size()
+                                                               : 0;
+
+        auto& scatter_map = scatter_maps.emplace_back(local_size * (local_size + 1) / 2,
+                                                      submesh.elements());
+
+        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+            auto const dof_view = submesh.local_dof_view(element);
+
+            std::int64_t entry{0};
+
+            for (std::int64_t a{0}; a < local_size; ++a)
+            {
+                for (std::int64_t b{a}; b < local_size; ++b)
+                {
+                    auto const row = std::min(dof_view(a), dof_view(b));
+                    auto const col = std::max(dof_view(a), dof_view(b));
+
+                    auto const location = std::lower_bound(inner_index + outer_index[row],
+                                                           inner_index + outer_index[row + 1],
+                                                           col);
+
+                    scatter_map(entry++, element) = std::distance(inner_index, location);
+                }
+            }
+        });
+    }
+    return scatter_maps;
+}
+
+/// Add the upper triangle of the symmetric element matrix \p local_matrix
+/// into the coefficients of the upper triangular matrix \p A.  The lower
+/// triangle of \p local_matrix is not accessed.
+/// \sa compute_upper_scatter_map
+template <typename sparse_matrix_type, typename offset_type, typename local_matrix_type>
+void scatter_add_upper(sparse_matrix_type& A,
+                       offset_type const& offsets,
+                       local_matrix_type const& local_matrix)
+{
+    auto* const values = A.valuePtr();
+
+    auto const local_size = local_matrix.rows();
+
+    std::int64_t entry{0};
+
+    for (std::int64_t a{0}; a < local_size; ++a)
+    {
+        for (std::int64_t b{a}; b < local_size; ++b)
         {
-            auto const local_dof_view = submesh.local_dof_view(element);
+            values[offsets(entry++)] += local_matrix(a, b);
+        }
+    }
+}
+
+/// Compute the scatter map for each submesh in \p mesh into the block matrix
+/// \p A.  Each element column holds the storage position of the block for
+/// every element node pair (row \f$ a n + b \f$ for the nodes \f$ (a, b) \f$
+/// of an element with \f$ n \f$ nodes).
+/// \sa scatter_add
+template <int BlockSize, typename mesh_type>
+[[nodiscard]] auto compute_scatter_map(block_sparse_matrix<BlockSize> const& A, mesh_type const& mesh)
+    -> std::vector<indices>
+{
+    std::vector<indices> scatter_maps;
+    scatter_maps.reserve(mesh.meshes().size());
 
-            for (std::int64_t p{0}; p < local_dof_view.size(); p++)
+    for (auto const& submesh : mesh.meshes())
+    {
+        std::int64_t const nodes_per_element = submesh.nodes_per_element();
+
+        auto& scatter_map = scatter_maps.emplace_back(nodes_per_element * nodes_per_element,
+                                                      submesh.elements());
+
+        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+            auto const node_view = submesh.local_node_view(element);
+
+            for (std::int64_t a{0}; a < nodes_per_element; ++a)
             {
-                for (std::int64_t q{0}; q < local_dof_view.size(); q++)
+                for (std::int64_t b{0}; b < nodes_per_element; ++b)
                 {
-                    ij.emplace_back(local_dof_view(p), local_dof_view(q));
+                    scatter_map(a * nodes_per_element + b, element) = A.find_block(node_view(a),
+                                                                                   node_view(b));
                 }
             }
+        });
+    }
+    return scatter_maps;
+}
+
+/// Add the element matrix \p local_matrix into the blocks of \p A using the
+/// element column of a block scatter map.  Concurrent calls must not share
+/// degrees of freedom, for example through an element colouring.
+/// \sa compute_scatter_map
+template <int BlockSize, typename offset_type, typename local_matrix_type>
+void scatter_add(block_sparse_matrix<BlockSize>& A,
+                 offset_type const& offsets,
+                 local_matrix_type const& local_matrix)
+{
+    auto const nodes_per_element = local_matrix.rows() / BlockSize;
+
+    for (std::int64_t a{0}; a < nodes_per_element; ++a)
+    {
+        for (std::int64_t b{0}; b < nodes_per_element; ++b)
+        {
+            A.block(offsets(a * nodes_per_element + b))
+                .noalias() += local_matrix.template block<BlockSize, BlockSize>(a * BlockSize,
+                                                                                b * BlockSize);
         }
     }
-    A.setFromTriplets(begin(ij), end(ij));
-    A.finalize();
 }
 }
@@ -35,6 +35,25 @@ public:
     /// \param time_step_size Time step size (or load increment if quasi-static)
     virtual void update_internal_variables(double const time_step_size) = 0;
 
+    /// Update the internal variables required for the stress without the
+    /// tangent matrix for an evaluation of the residual only.  Models that do
+    /// not check is_tangent_required perform the full update.
+    /// \param time_step_size Time step size (or load increment if quasi-static)
+    void update_stress(double const time_step_size)
+    {
+        is_tangent_required = false;
+        try
+        {
+            update_internal_variables(time_step_size);
+        }
+        catch (...)
+        {
+            is_tangent_required = true;
+            throw;
+        }
+        is_tangent_required = true;
+    }
+
     /// \return A base class reference to the common material properties
     [[nodiscard]] virtual material_property const& intrinsic_material() const = 0;
 
@@ -42,6 +61,11 @@ public:
 
     [[nodiscard]] virtual bool is_symmetric() const { return true; };
 
+    /// \return the tangent operator shared by the quadrature points that
+    /// remain elastic, or nullptr if the tangent operator is computed at
+    /// every quadrature point
+    [[nodiscard]] virtual FourthOrderTensor const* shared_tangent() const { return nullptr; }
+
     [[nodiscard]] auto variable_names() const noexcept -> std::set<std::string> const&
     {
         return names;
@@ -53,6 +77,9 @@ protected:
 
     /// Internal variable names allocated by the constitutive model
     std::set<std::string> names;
+
+    /// Flag for update_internal_variables to compute the tangent operator
+    bool is_tangent_required{true};
 };
 }
 
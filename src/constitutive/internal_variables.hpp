@@ -1,16 +1,19 @@
-
 #pragma once
 
 /// @file
 
 #include "internal_variables_forward.hpp"
 
+#include "numeric/aligned_vector.hpp"
 #include "numeric/dense_matrix.hpp"
+#include "numeric/packed_symmetric.hpp"
 #include "constitutive/variable_types.hpp"
 
+#include <array>
+#include <bitset>
 #include <functional>
-#include <map>
-#include <vector>
+#include <stdexcept>
+#include <string>
 #include <cstdint>
 
 namespace neon
@@ -19,6 +22,27 @@ namespace neon
 /// quadrature points.  These variables are duplicated and commited to memory
 /// when the data is converged to avoid polluting the variable history in the
 /// Newton-Raphson method.
+///
+/// Scalars and second order tensors marked as history variables are stored
+/// in two generations, the current values and the converged (old) values,
+/// while all other variables are only stored once.  A commit marks the current
+/// generation as converged and a revert exchanges the generations, such that
+/// neither copies any data.  The generations are separated again by advance at
+/// the start of the next update, where the converged values are copied into the
+/// current generation except for the variables marked as recomputed, which
+/// are overwritten by every update.
+///
+/// Each variable is a contiguous array with an entry for every quadrature
+/// point, aligned to a cache line and found by indexing a table with the
+/// variable name.  Second order tensors can additionally be stored with each
+/// tensor component in a separate array (a structure of arrays layout) such
+/// that a loop over the quadrature points operates on unit stride data.
+/// Fourth order tensors of symmetric constitutive models can be packed to the
+/// upper triangle of the Voigt matrix, which are then accessed through a view.
+/// The quadrature points can also refer to a fourth order tensor shared by the
+/// constitutive model through a tag, such that elastic points of a plasticity
+/// model do not write a copy of the elastic moduli at each update.  The
+/// storage of these points remains allocated since they can yield later.
 template <typename SecondTensorType, typename FourthTensorType>
 class internal_variables
 {
@@ -28,6 +52,27 @@ public:
     /// A fourth order tensor type is a fixed size matrix in Voigt notation
     using fourth_tensor_type = FourthTensorType;
 
+    /// Number of components in a second order tensor
+    static auto constexpr second_components = SecondTensorType::RowsAtCompileTime
+                                              * SecondTensorType::ColsAtCompileTime;
+
+    /// Second order tensors with the components in the columns and a row for
+    /// each quadrature point
+    using component_type = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, second_components>,
+                                      Eigen::Aligned64,
+                                      Eigen::OuterStride<>>;
+
+    /// Fourth order tensors stored in either the full or the packed layout
+    using voigt_view_type = voigt_tensor_view<FourthTensorType::RowsAtCompileTime>;
+    /// Upper triangle of a symmetric fourth order tensor
+    using packed_fourth_tensor_type = typename voigt_view_type::packed_type;
+
+    /// Constant second order tensors with the components in the columns
+    using const_component_type = Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, second_components> const,
+        Eigen::Aligned64,
+        Eigen::OuterStride<>>;
+
 public:
     internal_variables(std::size_t const size) : m_size{size} {}
 
@@ -44,8 +89,7 @@ public:
     template <typename... all_types>
     void add(variable::scalar const name, all_types const... names)
     {
-        m_scalars[name].resize(m_size, 0.0);
-        m_scalars_old[name].resize(m_size, 0.0);
+        add(name);
         add(names...);
     }
 
@@ -53,182 +97,562 @@ public:
     template <typename... all_types>
     void add(variable::second const name, all_types... names)
     {
-        m_second_order_tensors[name].resize(m_size, second_tensor_type::Zero());
-        m_second_order_tensors_old[name].resize(m_size, second_tensor_type::Zero());
+        add(name);
         add(names...);
     }
 
     /// Allocate scalars (defaulted to zeros)
     void add(variable::scalar const name, double const value = 0.0)
     {
-        m_scalars[name].resize(m_size, value);
-        m_scalars_old[name].resize(m_size, value);
+        m_scalars[index(name)].resize(m_size, value);
+        m_has_scalar.set(index(name));
+
+        if (m_scalar_history.test(index(name))) m_scalars_old[index(name)].resize(m_size, value);
     }
 
     /// Allocate second order tensors (defaulted to zeros)
     void add(variable::second const name)
     {
-        m_second_order_tensors[name].resize(m_size, second_tensor_type::Zero());
-        m_second_order_tensors_old[name].resize(m_size, second_tensor_type::Zero());
+        m_second_order_tensors[index(name)].resize(m_size, second_tensor_type::Zero());
+        m_has_second.set(index(name));
+
+        if (m_second_history.test(index(name)))
+        {
+            m_second_order_tensors_old[index(name)].resize(m_size, second_tensor_type::Zero());
+        }
     }
 
     /// Allocate fourth order tensor (defaulted to zeros)
     void add(variable::fourth const name, fourth_tensor_type const m = fourth_tensor_type::Zero())
     {
-        m_fourth_order_tensors[name].resize(m_size, m);
+        m_fourth_order_tensors[index(name)].resize(m_size, m);
+        m_has_fourth.set(index(name));
     }
 
-    bool has(variable::scalar const name) const { return m_scalars.find(name) != m_scalars.end(); }
-
-    bool has(variable::second const name) const
+    /// Allocate second order tensors in the structure of arrays layout
+    /// (defaulted to zeros), where each component begins on a cache line
+    void add_components(variable::second const name)
     {
-        return m_second_order_tensors.find(name) != m_second_order_tensors.end();
+        m_components[index(name)].resize(component_stride() * second_components, 0.0);
+        m_has_components.set(index(name));
+
+        if (m_second_history.test(index(name)))
+        {
+            m_components_old[index(name)].resize(component_stride() * second_components, 0.0);
+        }
     }
 
+    bool has(variable::scalar const name) const { return m_has_scalar.test(index(name)); }
+
+    bool has(variable::second const name) const { return m_has_second.test(index(name)); }
+
     bool has(variable::fourth const name) const
     {
-        return m_fourth_order_tensors.find(name) != m_fourth_order_tensors.end();
+        return m_has_fourth.test(index(name)) || is_packed(name);
+    }
+
+    /// \return true if the fourth order tensor is stored in the packed layout
+    bool is_packed(variable::fourth const name) const { return m_is_packed.test(index(name)); }
+
+    /// Store the fourth order tensor in the packed layout, which keeps only
+    /// the upper triangle of each existing value and releases the full
+    /// matrices.  The tensor is then only accessed through voigt_view and
+    /// this is called by the submeshes on construction for constitutive models
+    /// with a major symmetric tangent.
+    void pack(variable::fourth const name)
+    {
+        if (!has(name))
+        {
+            throw std::domain_error("Fourth order tensor " + std::to_string(static_cast<int>(name))
+                                    + " does not exist in the variable table");
+        }
+        if (is_packed(name)) return;
+
+        auto& full = m_fourth_order_tensors[index(name)];
+        auto& packed = m_packed_fourth_order_tensors[index(name)];
+
+        packed.resize(m_size);
+
+        for (std::size_t l{0}; l < m_size; ++l)
+        {
+            packed[l] = pack_symmetric<fourth_tensor_type::RowsAtCompileTime>(full[l]);
+        }
+        aligned_vector<fourth_tensor_type>().swap(full);
+
+        m_has_fourth.reset(index(name));
+        m_is_packed.set(index(name));
+    }
+
+    /// \return true if the quadrature points can refer to a shared tensor
+    bool is_shared(variable::fourth const name) const { return m_is_shared.test(index(name)); }
+
+    /// Allow the quadrature points to refer to the shared tensor \p value in
+    /// place of the stored value, which is tagged for each quadrature point by
+    /// the constitutive model through voigt_view.  This is called by the
+    /// submeshes on construction for constitutive models that provide a shared
+    /// tangent operator.
+    void share(variable::fourth const name, fourth_tensor_type const& value)
+    {
+        if (!has(name))
+        {
+            throw std::domain_error("Fourth order tensor " + std::to_string(static_cast<int>(name))
+                                    + " does not exist in the variable table");
+        }
+        m_shared_fourth_order_tensors[index(name)] = value;
+        m_shared_tags[index(name)].resize(m_size, 0);
+
+        m_is_shared.set(index(name));
+    }
+
+    /// \return true if the second order tensor is stored in the structure of
+    /// arrays layout
+    bool has_components(variable::second const name) const
+    {
+        return m_has_components.test(index(name));
+    }
+
+    /// Mark scalars that carry history between increments, which are either
+    /// read through get_old or accumulated from their current values.  Only
+    /// these variables are stored with a converged copy and this is called by
+    /// the submeshes and the constitutive models on construction, before or
+    /// after the variables are added.
+    template <typename... scalar_types>
+    void mark_history(variable::scalar const name, scalar_types const... names)
+    {
+        m_scalar_history.set(index(name));
+
+        if (has(name)) m_scalars_old[index(name)] = m_scalars[index(name)];
+
+        if constexpr (sizeof...(names) > 0) mark_history(names...);
+    }
+
+    /// Mark second order tensors that carry history between increments
+    /// \sa mark_history
+    template <typename... second_types>
+    void mark_history(variable::second const name, second_types const... names)
+    {
+        m_second_history.set(index(name));
+
+        if (has(name))
+        {
+            m_second_order_tensors_old[index(name)] = m_second_order_tensors[index(name)];
+        }
+        if (has_components(name)) m_components_old[index(name)] = m_components[index(name)];
+
+        if constexpr (sizeof...(names) > 0) mark_history(names...);
+    }
+
+    /// \return true if the scalar is stored with a converged copy
+    bool has_history(variable::scalar const name) const
+    {
+        return m_scalar_history.test(index(name));
+    }
+
+    /// \return true if the second order tensor is stored with a converged copy
+    bool has_history(variable::second const name) const
+    {
+        return m_second_history.test(index(name));
+    }
+
+    /// Mark scalars that are overwritten at every quadrature point by each
+    /// update, which are then not copied from the converged values on advance
+    template <typename... scalar_types>
+    void mark_recomputed(variable::scalar const name, scalar_types const... names)
+    {
+        m_scalar_recomputed.set(index(name));
+        (m_scalar_recomputed.set(index(names)), ...);
+    }
+
+    /// Mark second order tensors that are overwritten at every quadrature
+    /// point by each update \sa mark_recomputed
+    template <typename... second_types>
+    void mark_recomputed(variable::second const name, second_types const... names)
+    {
+        m_second_recomputed.set(index(name));
+        (m_second_recomputed.set(index(names)), ...);
     }
 
     /// Const access to the converged tensor variables
-    std::vector<second_tensor_type> const& get_old(variable::second const name) const
+    aligned_vector<second_tensor_type> const& get_old(variable::second const name) const
     {
-        return m_second_order_tensors_old.find(name)->second;
+        if (!has_history(name))
+        {
+            throw std::domain_error("Second order tensor " + std::to_string(static_cast<int>(name))
+                                    + " is not a history variable");
+        }
+        return m_is_converged ? m_second_order_tensors[index(name)]
+                              : m_second_order_tensors_old[index(name)];
     }
 
     /// Const access to the converged scalar variables
-    std::vector<double> const& get_old(variable::scalar const name) const
+    aligned_vector<double> const& get_old(variable::scalar const name) const
     {
-        return m_scalars_old.find(name)->second;
+        if (!has_history(name))
+        {
+            throw std::domain_error("Scalar " + std::to_string(static_cast<int>(name))
+                                    + " is not a history variable");
+        }
+        return m_is_converged ? m_scalars[index(name)] : m_scalars_old[index(name)];
     }
 
     /// Mutable access to the non-converged scalar variables
-    std::vector<double>& get(variable::scalar const name)
+    aligned_vector<double>& get(variable::scalar const name)
     {
         if (!has(name))
         {
             throw std::domain_error("Scalar " + std::to_string(static_cast<int>(name))
                                     + " does not exist in the variable table");
         }
-        return m_scalars.find(name)->second;
+        return m_scalars[index(name)];
     }
 
     /// Mutable access to the non-converged second order tensor variables
-    std::vector<second_tensor_type>& get(variable::second const name)
+    aligned_vector<second_tensor_type>& get(variable::second const name)
     {
         if (!has(name))
         {
             throw std::domain_error("Second order tensor " + std::to_string(static_cast<int>(name))
                                     + " does not exist in the variable table");
         }
-        return m_second_order_tensors.find(name)->second;
+        return m_second_order_tensors[index(name)];
     }
 
     /// Mutable access to the non-converged fourth order tensor variables
-    std::vector<fourth_tensor_type>& get(variable::fourth const name)
+    aligned_vector<fourth_tensor_type>& get(variable::fourth const name)
+    {
+        if (!m_has_fourth.test(index(name)))
+        {
+            throw std::domain_error("Fourth order tensor " + std::to_string(static_cast<int>(name))
+                                    + (is_packed(name) ? " is stored in the packed layout"
+                                                       : " does not exist in the variable table"));
+        }
+        if (is_shared(name))
+        {
+            throw std::domain_error("Fourth order tensor " + std::to_string(static_cast<int>(name))
+                                    + " refers to a shared tensor");
+        }
+        return m_fourth_order_tensors[index(name)];
+    }
+
+    /// Mutable access to the non-converged fourth order tensor variables in
+    /// either the full or the packed layout
+    voigt_view_type voigt_view(variable::fourth const name)
     {
         if (!has(name))
         {
             throw std::domain_error("Fourth order tensor " + std::to_string(static_cast<int>(name))
                                     + " does not exist in the variable table");
         }
-        return m_fourth_order_tensors.find(name)->second;
+
+        auto view = is_packed(name)
+                        ? voigt_view_type(m_packed_fourth_order_tensors[index(name)].data())
+                        : voigt_view_type(m_fourth_order_tensors[index(name)].data());
+
+        if (is_shared(name))
+        {
+            view.share(&m_shared_fourth_order_tensors[index(name)],
+                       m_shared_tags[index(name)].data());
+        }
+        return view;
     }
 
     /// Mutable access to the non-converged scalar variables
     template <typename... scalar_types>
     auto get(variable::scalar const var0, scalar_types const... vars)
     {
-        return std::make_tuple(std::ref(m_scalars.find(var0)->second),
-                               std::ref(m_scalars.find(vars)->second)...);
+        return std::make_tuple(std::ref(m_scalars[index(var0)]),
+                               std::ref(m_scalars[index(vars)])...);
     }
 
     /// Mutable access to the non-converged tensor variables
     template <typename... second_types>
     auto get(variable::second const var0, second_types const... vars)
     {
-        return std::make_tuple(std::ref(m_second_order_tensors.find(var0)->second),
-                               std::ref(m_second_order_tensors.find(vars)->second)...);
+        return std::make_tuple(std::ref(m_second_order_tensors[index(var0)]),
+                               std::ref(m_second_order_tensors[index(vars)])...);
     }
 
     template <typename... fourth_types>
     auto get(variable::fourth const var0, fourth_types const... vars)
     {
-        return std::make_tuple(std::ref(m_fourth_order_tensors.find(var0)->second),
-                               std::ref(m_fourth_order_tensors.find(vars)->second)...);
+        return std::make_tuple(std::ref(m_fourth_order_tensors[index(var0)]),
+                               std::ref(m_fourth_order_tensors[index(vars)])...);
     }
 
     /// Constant access to the non-converged scalar variables
-    std::vector<double> const& get(variable::scalar const name) const
+    aligned_vector<double> const& get(variable::scalar const name) const
     {
-        return m_scalars.find(name)->second;
+        return m_scalars[index(name)];
     }
 
     /// Non-mutable access to the non-converged tensor variables
-    std::vector<second_tensor_type> const& get(variable::second const name) const
+    aligned_vector<second_tensor_type> const& get(variable::second const name) const
     {
-        return m_second_order_tensors.find(name)->second;
+        return m_second_order_tensors[index(name)];
     }
 
     /// Non-mutable access to the non-converged matrix variables
-    std::vector<fourth_tensor_type> const& get(variable::fourth const name) const
+    aligned_vector<fourth_tensor_type> const& get(variable::fourth const name) const
     {
-        return m_fourth_order_tensors.find(name)->second;
+        return m_fourth_order_tensors[index(name)];
     }
 
     /// Const access to the non-converged scalar variables
     template <typename... scalar_types>
     auto get(variable::scalar const var0, scalar_types const... vars) const
     {
-        return std::make_tuple(std::cref(m_scalars.find(var0)->second),
-                               std::cref(m_scalars.find(vars)->second)...);
+        return std::make_tuple(std::cref(get(var0)), std::cref(get(vars))...);
     }
 
     /// Const access to the non-converged tensor variables
     template <typename... tensor_types>
     auto get(variable::second const var0, tensor_types const... vars) const
     {
-        return std::make_tuple(std::cref(m_second_order_tensors.find(var0)->second),
-                               std::cref(m_second_order_tensors.find(vars)->second)...);
+        return std::make_tuple(std::cref(get(var0)), std::cref(get(vars))...);
     }
 
     template <typename... fourth_types>
     auto get(variable::fourth const var0, fourth_types const... vars) const
     {
-        return std::make_tuple(std::cref(m_fourth_order_tensors.find(var0)->second),
-                               std::cref(m_fourth_order_tensors.find(vars)->second)...);
+        return std::make_tuple(std::cref(get(var0)), std::cref(get(vars))...);
     }
 
-    /// Commit to history when iteration converges
-    void commit()
+    /// Mutable access to the non-converged second order tensor components.  The
+    /// map refers to the storage of one generation and is retrieved for each
+    /// update since a commit or a revert can exchange the storage.
+    component_type components(variable::second const name)
+    {
+        if (!has_components(name))
+        {
+            throw std::domain_error("Second order tensor components "
+                                    + std::to_string(static_cast<int>(name))
+                                    + " do not exist in the variable table");
+        }
+        return {m_components[index(name)].data(),
+                static_cast<Eigen::Index>(m_size),
+                second_components,
+                Eigen::OuterStride<>(component_stride())};
+    }
+
+    /// Const access to the non-converged second order tensor components
+    const_component_type components(variable::second const name) const
     {
-        m_scalars_old = m_scalars;
-        m_second_order_tensors_old = m_second_order_tensors;
+        return {m_components[index(name)].data(),
+                static_cast<Eigen::Index>(m_size),
+                second_components,
+                Eigen::OuterStride<>(component_stride())};
+    }
+
+    /// Const access to the converged second order tensor components
+    const_component_type components_old(variable::second const name) const
+    {
+        if (!has_history(name))
+        {
+            throw std::domain_error("Second order tensor components "
+                                    + std::to_string(static_cast<int>(name))
+                                    + " are not a history variable");
+        }
+        return {m_is_converged ? m_components[index(name)].data()
+                               : m_components_old[index(name)].data(),
+                static_cast<Eigen::Index>(m_size),
+                second_components,
+                Eigen::OuterStride<>(component_stride())};
     }
 
+    /// Commit to history when iteration converges
+    void commit() noexcept { m_is_converged = true; }
+
     /// Revert to the old state when iteration doesn't converge
-    void revert()
+    void revert() noexcept
     {
-        m_scalars = m_scalars_old;
-        m_second_order_tensors = m_second_order_tensors_old;
+        if (m_is_converged) return;
+
+        exchange_allocated(m_scalars, m_scalars_old, m_has_scalar & m_scalar_history);
+        exchange_allocated(m_second_order_tensors,
+                           m_second_order_tensors_old,
+                           m_has_second & m_second_history);
+        exchange_allocated(m_components, m_components_old, m_has_components & m_second_history);
+
+        m_is_converged = true;
+    }
+
+    /// Begin an update from the converged state, which must be called before
+    /// the current values are modified and has no effect until the next commit
+    /// or revert
+    void advance()
+    {
+        if (!m_is_converged) return;
+
+        auto const scalars = m_has_scalar & m_scalar_history;
+        auto const seconds = m_has_second & m_second_history;
+        auto const components = m_has_components & m_second_history;
+
+        exchange_allocated(m_scalars, m_scalars_old, scalars);
+        exchange_allocated(m_second_order_tensors, m_second_order_tensors_old, seconds);
+        exchange_allocated(m_components, m_components_old, components);
+
+        copy_allocated(m_scalars_old, m_scalars, scalars & ~m_scalar_recomputed);
+        copy_allocated(m_second_order_tensors_old,
+                       m_second_order_tensors,
+                       seconds & ~m_second_recomputed);
+        copy_allocated(m_components_old, m_components, components & ~m_second_recomputed);
+
+        m_is_converged = false;
+    }
+
+    /// Store the current values of the history variables such that a trial
+    /// update, which accumulates into the history in place, can be undone by
+    /// restore.  The storage is allocated by the first checkpoint.
+    void checkpoint()
+    {
+        auto const scalars = m_has_scalar & m_scalar_history & ~m_scalar_recomputed;
+        auto const seconds = m_has_second & m_second_history & ~m_second_recomputed;
+        auto const components = m_has_components & m_second_history & ~m_second_recomputed;
+
+        copy_allocated(m_scalars, m_scalars_checkpoint, scalars);
+        copy_allocated(m_second_order_tensors, m_second_order_tensors_checkpoint, seconds);
+        copy_allocated(m_components, m_components_checkpoint, components);
+    }
+
+    /// Recover the values of the history variables from the last checkpoint
+    void restore()
+    {
+        auto const scalars = m_has_scalar & m_scalar_history & ~m_scalar_recomputed;
+        auto const seconds = m_has_second & m_second_history & ~m_second_recomputed;
+        auto const components = m_has_components & m_second_history & ~m_second_recomputed;
+
+        copy_allocated(m_scalars_checkpoint, m_scalars, scalars);
+        copy_allocated(m_second_order_tensors_checkpoint, m_second_order_tensors, seconds);
+        copy_allocated(m_components_checkpoint, m_components, components);
     }
 
     /// \return Number of internal variables
     auto size() const noexcept -> std::size_t { return m_size; }
 
+    /// \return the number of bytes allocated for the current values of the
+    /// variables
+    auto allocated_bytes() const noexcept -> std::size_t
+    {
+        return table_bytes(m_scalars) + table_bytes(m_second_order_tensors)
+               + table_bytes(m_components) + table_bytes(m_fourth_order_tensors)
+               + table_bytes(m_packed_fourth_order_tensors) + table_bytes(m_shared_tags);
+    }
+
+    /// \return the number of bytes allocated for the converged copies of the
+    /// history variables
+    auto history_bytes() const noexcept -> std::size_t
+    {
+        return table_bytes(m_scalars_old) + table_bytes(m_second_order_tensors_old)
+               + table_bytes(m_components_old);
+    }
+
+protected:
+    template <typename EnumType>
+    static constexpr auto index(EnumType const name) noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(name);
+    }
+
+    /// \return the distance between the components in the structure of arrays
+    /// layout, which is padded to a multiple of the storage alignment
+    auto component_stride() const noexcept -> Eigen::Index
+    {
+        auto constexpr padding = storage_alignment / sizeof(double);
+
+        return static_cast<Eigen::Index>((m_size + padding - 1) / padding * padding);
+    }
+
+    /// Copy the flagged variables from \p source into \p destination, which
+    /// have the same size and therefore reuse the existing storage
+    template <typename TableType, typename FlagType>
+    static void copy_allocated(TableType const& source,
+                               TableType& destination,
+                               FlagType const& flags)
+    {
+        for (std::size_t name{0}; name < flags.size(); ++name)
+        {
+            if (flags.test(name)) destination[name] = source[name];
+        }
+    }
+
+    template <typename TableType>
+    static auto table_bytes(TableType const& table) noexcept -> std::size_t
+    {
+        std::size_t bytes{0};
+        for (auto const& values : table)
+        {
+            bytes += values.capacity() * sizeof(typename TableType::value_type::value_type);
+        }
+        return bytes;
+    }
+
+    /// Exchange the storage of the flagged variables in \p left and \p right
+    template <typename TableType, typename FlagType>
+    static void exchange_allocated(TableType& left,
+                                   TableType& right,
+                                   FlagType const& flags) noexcept
+    {
+        for (std::size_t name{0}; name < flags.size(); ++name)
+        {
+            if (flags.test(name)) left[name].swap(right[name]);
+        }
+    }
+
 protected:
     /// scalar history
-    std::map<variable::scalar, std::vector<double>> m_scalars;
+    std::array<aligned_vector<double>, variable::scalar_count> m_scalars;
     /// old scalar history
-    std::map<variable::scalar, std::vector<double>> m_scalars_old;
+    std::array<aligned_vector<double>, variable::scalar_count> m_scalars_old;
 
     /// second order tensors
-    std::map<variable::second, std::vector<second_tensor_type>> m_second_order_tensors;
+    std::array<aligned_vector<second_tensor_type>, variable::second_count> m_second_order_tensors;
     /// old second order tensors
-    std::map<variable::second, std::vector<second_tensor_type>> m_second_order_tensors_old;
+    std::array<aligned_vector<second_tensor_type>, variable::second_count>
+        m_second_order_tensors_old;
+
+    /// second order tensors in the structure of arrays layout
+    std::array<aligned_vector<double>, variable::second_count> m_components;
+    /// old second order tensors in the structure of arrays layout
+    std::array<aligned_vector<double>, variable::second_count> m_components_old;
+
+    /// Checkpoint of the history variables for trial updates
+    std::array<aligned_vector<double>, variable::scalar_count> m_scalars_checkpoint;
+    std::array<aligned_vector<second_tensor_type>, variable::second_count>
+        m_second_order_tensors_checkpoint;
+    std::array<aligned_vector<double>, variable::second_count> m_components_checkpoint;
 
     /// Fourth order tensors
-    std::map<variable::fourth, std::vector<fourth_tensor_type>> m_fourth_order_tensors;
+    std::array<aligned_vector<fourth_tensor_type>, variable::fourth_count> m_fourth_order_tensors;
+    /// Fourth order tensors in the packed layout
+    std::array<aligned_vector<packed_fourth_tensor_type>, variable::fourth_count>
+        m_packed_fourth_order_tensors;
+
+    /// Fourth order tensors shared by the tagged quadrature points
+    std::array<fourth_tensor_type, variable::fourth_count> m_shared_fourth_order_tensors;
+    /// Quadrature point tags for the shared fourth order tensors
+    std::array<aligned_vector<std::uint8_t>, variable::fourth_count> m_shared_tags;
+
+    /// Variables that have been allocated
+    std::bitset<variable::scalar_count> m_has_scalar;
+    std::bitset<variable::second_count> m_has_second;
+    std::bitset<variable::second_count> m_has_components;
+    std::bitset<variable::fourth_count> m_has_fourth;
+
+    /// Fourth order tensors stored in the packed layout
+    std::bitset<variable::fourth_count> m_is_packed;
+    /// Fourth order tensors that can refer to a shared tensor
+    std::bitset<variable::fourth_count> m_is_shared;
+
+    /// Variables that are stored with a converged copy
+    std::bitset<variable::scalar_count> m_scalar_history;
+    std::bitset<variable::second_count> m_second_history;
+
+    /// Variables that are overwritten by every update
+    std::bitset<variable::scalar_count> m_scalar_recomputed;
+    std::bitset<variable::second_count> m_second_recomputed;
+
+    /// Flag if the current values are the converged values
+    bool m_is_converged{true};
 
     std::size_t m_size;
 };
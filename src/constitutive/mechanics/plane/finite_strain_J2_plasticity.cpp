@@ -25,6 +25,11 @@ finite_strain_J2_plasticity::finite_strain_J2_plasticity(std::shared_ptr<interna
                    variable::scalar::effective_plastic_strain,
                    variable::second::hencky_strain_elastic);
 
+    // The incremental deformation is computed from the converged deformation
+    // gradient and the elastic strain is updated from its previous value
+    variables->mark_history(variable::second::deformation_gradient,
+                            variable::second::hencky_strain_elastic);
+
     names.emplace("hencky_strain_elastic");
 
     // Add material tangent with the linear elasticity moduli
@@ -20,6 +20,9 @@ isotropic_linear_elasticity::isotropic_linear_elasticity(std::shared_ptr<interna
 {
     variables->add(variable::second::linearised_strain, variable::scalar::von_mises_stress);
 
+    variables->mark_recomputed(variable::second::linearised_strain);
+    variables->mark_recomputed(variable::scalar::von_mises_stress);
+
     names.emplace("linearised_strain");
     names.emplace("von_mises_stress");
 
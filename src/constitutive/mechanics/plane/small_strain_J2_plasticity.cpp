@@ -23,6 +23,10 @@ small_strain_J2_plasticity::small_strain_J2_plasticity(std::shared_ptr<internal_
     variables->add(variable::second::linearised_plastic_strain);
     variables->add(variable::scalar::effective_plastic_strain);
 
+    // The plastic strains are accumulated over the increments
+    variables->mark_history(variable::second::linearised_plastic_strain,
+                            variable::scalar::effective_plastic_strain);
+
     names.emplace("linearised_plastic_strain");
     names.emplace("effective_plastic_strain");
 
@@ -43,7 +47,7 @@ void small_strain_J2_plasticity::update_internal_variables(double)
     auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
     auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
 
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     // Compute the linear strain gradient from the displacement gradient
     strains = variables->get(variable::second::displacement_gradient)
@@ -65,11 +69,11 @@ void small_strain_J2_plasticity::update_internal_variables(double)
         // Trial von Mises stress
         von_mises = von_mises_stress(cauchy_stress);
 
-        // If this quadrature point is elastic, then set the tangent to the
+        // If this quadrature point is elastic, then refer the tangent to the
         // elastic modulus and continue to the next quadrature point
         if (evaluate_J2_yield_function(material, von_mises, accumulated_plastic_strain) <= 0.0)
         {
-            tangent_operators[l] = C_e;
+            tangent_operators.assign_shared(l, C_e);
             return;
         }
 
@@ -89,14 +93,15 @@ void small_strain_J2_plasticity::update_internal_variables(double)
 
         accumulated_plastic_strain += plastic_increment;
 
-        tangent_operators[l] = algorithmic_tangent(material.shear_modulus(),
-                                                   material.hardening_modulus(
-                                                       accumulated_plastic_strain),
-                                                   plastic_increment,
-                                                   von_mises_trial,
-                                                   normal,
-                                                   I_dev,
-                                                   C_e);
+        tangent_operators.assign(l,
+                                 algorithmic_tangent(material.shear_modulus(),
+                                                     material.hardening_modulus(
+                                                         accumulated_plastic_strain),
+                                                     plastic_increment,
+                                                     von_mises_trial,
+                                                     normal,
+                                                     I_dev,
+                                                     C_e));
     });
 }
 
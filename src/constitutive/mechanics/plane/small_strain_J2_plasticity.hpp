@@ -31,6 +31,9 @@ public:
 
     virtual bool is_finite_deformation() const override { return false; }
 
+    /// Elastic quadrature points refer to the elastic moduli
+    virtual matrix3 const* shared_tangent() const override { return &C_e; }
+
 protected:
     /**
      * Performs the radial return algorithm with nonlinear hardening for
@@ -22,7 +22,7 @@ affine_microsphere::affine_microsphere(std::shared_ptr<internal_variables_t>& va
 
 void affine_microsphere::update_internal_variables(double)
 {
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
     auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
     auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
@@ -43,10 +43,12 @@ void affine_microsphere::update_internal_variables(double)
 
         cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_stress) / J;
 
-        tangent_operators[l] = compute_material_tangent(J,
-                                                        K,
-                                                        compute_macro_moduli(F_bar, G, N),
-                                                        macro_stress);
+        if (!is_tangent_required) return;
+
+        tangent_operators.assign(l, compute_material_tangent(J,
+                                                             K,
+                                                             compute_macro_moduli(F_bar, G, N),
+                                                             macro_stress));
     });
 }
 
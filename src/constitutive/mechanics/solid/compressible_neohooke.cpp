@@ -20,7 +20,7 @@ void compressible_neohooke::update_internal_variables(double)
           cauchy_stresses] = variables->get(variable::second::deformation_gradient,
                                             variable::second::cauchy_stress);
 
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
     auto const& determinants = variables->get(variable::scalar::DetF);
 
     // compute stresses
@@ -40,52 +40,22 @@ void compressible_neohooke::update_internal_variables(double)
                        return (lambda * std::log(J) * I + shear_modulus * (B - I)) / J;
                    });
 
+    if (!is_tangent_required) return;
+
+    auto const [lambda, shear_modulus_0] = material.Lame_parameters();
+
     // compute material tangent operators
-    std::transform(begin(determinants),
-                   end(determinants),
-                   begin(tangent_operators),
-                   [&](double const J) -> matrix6 {
-                       auto const [lambda, shear_modulus_0] = material.Lame_parameters();
+    for (std::size_t l{0}; l < determinants.size(); ++l)
+    {
+        auto const shear_modulus = shear_modulus_0 - lambda * std::log(determinants[l]);
 
-                       auto const shear_modulus = shear_modulus_0 - lambda * std::log(J);
+        matrix6 D = matrix6::Zero();
 
-                       return (matrix6() << lambda + 2.0 * shear_modulus,
-                               lambda,
-                               lambda,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               lambda,
-                               lambda + 2.0 * shear_modulus,
-                               lambda,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               lambda,
-                               lambda,
-                               lambda + 2.0 * shear_modulus,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus,
-                               0.0,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus)
-                           .finished();
-                   });
+        D.topLeftCorner<3, 3>().setConstant(lambda);
+        D.topLeftCorner<3, 3>().diagonal().array() += 2.0 * shear_modulus;
+        D.bottomRightCorner<3, 3>().diagonal().setConstant(shear_modulus);
+
+        tangent_operators.assign(l, D);
+    }
 }
 }
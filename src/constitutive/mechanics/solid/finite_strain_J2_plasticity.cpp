@@ -21,6 +21,11 @@ finite_strain_J2_plasticity::finite_strain_J2_plasticity(std::shared_ptr<interna
 {
     variables->add(variable::second::hencky_strain_elastic);
 
+    // The incremental deformation is computed from the converged deformation
+    // gradient and the elastic strain is updated from its previous value
+    variables->mark_history(variable::second::deformation_gradient,
+                            variable::second::hencky_strain_elastic);
+
     names.emplace("hencky_strain_elastic");
 
     // Add material tangent with the linear elasticity moduli
@@ -52,7 +57,7 @@ void finite_strain_J2_plasticity::update_internal_variables(double)
           von_mises_stresses] = variables->get(variable::scalar::effective_plastic_strain,
                                                variable::scalar::von_mises_stress);
 
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     auto const incremental_deformation_gradients = view::zip(deformation_gradients,
                                                              old_deformation_gradients)
@@ -104,7 +109,7 @@ void finite_strain_J2_plasticity::update_internal_variables(double)
         // and decide if the stress return needs to be computed
         if (auto const f = evaluate_yield_function(von_mises, accumulated_plastic_strain); f <= 0.0)
         {
-            tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, C_e);
+            tangent_operators.assign(l, consistent_tangent(J, log_strain_e, cauchy_stress, C_e));
             continue;
         }
 
@@ -139,7 +144,7 @@ void finite_strain_J2_plasticity::update_internal_variables(double)
                                                  normal);
 
         // Compute the elastic-plastic tangent modulus for large strain
-        tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, D_ep);
+        tangent_operators.assign(l, consistent_tangent(J, log_strain_e, cauchy_stress, D_ep));
     }
 }
 
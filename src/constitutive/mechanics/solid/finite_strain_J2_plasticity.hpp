@@ -37,6 +37,9 @@ public:
 
     virtual bool is_finite_deformation() const override final { return true; };
 
+    /// The elastic tangent operator depends on the elastic strain
+    virtual matrix6 const* shared_tangent() const override final { return nullptr; }
+
 protected:
     /**
      * Computes the tangent modulus \f$\mathbf{c}\f$ for use in the small strain material tangent
@@ -22,7 +22,7 @@ gaussian_affine_microsphere::gaussian_affine_microsphere(std::shared_ptr<interna
 
 void gaussian_affine_microsphere::update_internal_variables(double)
 {
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
     auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
@@ -45,7 +45,9 @@ void gaussian_affine_microsphere::update_internal_variables(double)
 
         cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_stress) / J;
 
-        tangent_operators[l] = compute_material_tangent(J, K, matrix6::Zero(), macro_stress);
+        if (!is_tangent_required) return;
+
+        tangent_operators.assign(l, compute_material_tangent(J, K, matrix6::Zero(), macro_stress));
     });
 }
 
@@ -27,6 +27,17 @@ gaussian_ageing_affine_microsphere::gaussian_ageing_affine_microsphere(
 
     variables->add(variable::second::intermediate_secondary_kirchhoff_stress);
 
+    // The network evolution is integrated from the previous values and the
+    // secondary stress is accumulated from the converged value
+    variables->mark_history(variable::scalar::active_shear_modulus,
+                            variable::scalar::inactive_shear_modulus,
+                            variable::scalar::active_segments,
+                            variable::scalar::inactive_segments,
+                            variable::scalar::reduction_factor,
+                            variable::second::intermediate_secondary_kirchhoff_stress);
+
+    variables->mark_recomputed(variable::second::intermediate_secondary_kirchhoff_stress);
+
     names.emplace("active_shear_modulus");
     names.emplace("inactive_shear_modulus");
     names.emplace("active_segments");
@@ -71,7 +82,7 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
     auto const& det_F = variables->get(variable::scalar::DetF);
 
     auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     auto const K{material.bulk_modulus()};
 
@@ -132,7 +143,8 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
 
         cauchy_stresses[index] = compute_kirchhoff_stress(pressure, macro_stress) / J;
 
-        tangent_operators[index] = compute_material_tangent(J, K, matrix6::Zero(), macro_stress);
+        tangent_operators.assign(index,
+                                 compute_material_tangent(J, K, matrix6::Zero(), macro_stress));
     });
 }
 
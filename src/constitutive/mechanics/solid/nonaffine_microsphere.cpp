@@ -32,7 +32,7 @@ void nonaffine_microsphere::update_internal_variables(double)
     auto const& detF_list = variables->get(variable::scalar::DetF);
 
     // Compute tangent moduli
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     // Material properties
     auto const K_eff = material.bulk_modulus();
@@ -86,7 +86,8 @@ void nonaffine_microsphere::update_internal_variables(double)
 
         // Perform the deviatoric projection for the stress and macro moduli
         cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_kirchhoff) / J;
-        tangent_operators[l] = compute_material_tangent(J, K_eff, macro_moduli, macro_kirchhoff);
+        tangent_operators.assign(l,
+                                 compute_material_tangent(J, K_eff, macro_moduli, macro_kirchhoff));
     });
 }
 
@@ -31,6 +31,9 @@ public:
 
     virtual bool is_finite_deformation() const override { return false; }
 
+    /// Elastic quadrature points refer to the elastic moduli
+    virtual matrix6 const* shared_tangent() const override { return &C_e; }
+
 protected:
     [[nodiscard]] matrix6 algorithmic_tangent(double const plastic_increment,
                                               double const accumulated_plastic_strain,
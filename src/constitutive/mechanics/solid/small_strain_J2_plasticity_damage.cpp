@@ -23,6 +23,10 @@ small_strain_J2_plasticity_damage::small_strain_J2_plasticity_damage(
                    variable::scalar::damage,
                    variable::scalar::energy_release_rate);
 
+    variables->mark_history(variable::second::back_stress,
+                            variable::second::kinematic_hardening,
+                            variable::scalar::damage);
+
     names.emplace("back_stress");
     names.emplace("kinematic_hardening");
     names.emplace("damage");
@@ -43,6 +43,9 @@ public:
 
     virtual bool is_symmetric() const override { return false; };
 
+    /// The elastic tangent operator is reduced by the damage
+    virtual matrix6 const* shared_tangent() const override { return nullptr; }
+
 protected:
     /**
      * Performs the radial return algorithm with nonlinear kinematic hardening and damage.
@@ -3,6 +3,7 @@
 
 /// @file
 
+#include <cstddef>
 #include <variant>
 
 /// Define namespace for variable enumeration types
@@ -50,6 +51,10 @@ enum class scalar : short {
     second_moment_area_2
 };
 
+/// Number of scalar names, defined by the last enumerator
+inline constexpr std::size_t scalar_count
+    = static_cast<std::size_t>(scalar::second_moment_area_2) + 1;
+
 /// Second order tensor internal variables types
 enum class second : short {
     /// Cauchy stress
@@ -88,11 +93,18 @@ enum class second : short {
     intermediate_secondary_kirchhoff_stress
 };
 
+/// Number of second order tensor names, defined by the last enumerator
+inline constexpr std::size_t second_count
+    = static_cast<std::size_t>(second::intermediate_secondary_kirchhoff_stress) + 1;
+
 /// Fourth order tensor types
 enum class fourth : short {
     /// Material tangent operator
     tangent_operator
 };
 
+/// Number of fourth order tensor names, defined by the last enumerator
+inline constexpr std::size_t fourth_count = static_cast<std::size_t>(fourth::tangent_operator) + 1;
+
 using types = std::variant<scalar, second, fourth, nodal>;
 }
@@ -6,10 +6,19 @@
 namespace neon::geometry
 {
 matrix2x project_to_plane(matrix3x const& nodal_coordinates)
+{
+    matrix2x plane_coordinates;
+
+    project_to_plane(plane_coordinates, nodal_coordinates);
+
+    return plane_coordinates;
+}
+
+void project_to_plane(matrix2x& plane_coordinates, matrix3x const& nodal_coordinates)
 {
     auto const lnodes = nodal_coordinates.cols();
 
-    matrix2x plane_coordinates = matrix::Zero(2, lnodes);
+    plane_coordinates.resize(2, lnodes);
 
     auto const normal = unit_outward_normal(nodal_coordinates);
 
@@ -37,7 +46,6 @@ matrix2x project_to_plane(matrix3x const& nodal_coordinates)
         plane_coordinates(0, lnode) = e1.dot(nodal_coordinates.col(lnode));
         plane_coordinates(1, lnode) = e2.dot(nodal_coordinates.col(lnode));
     }
-    return plane_coordinates;
 }
 
 vector3 unit_outward_normal(matrix3x const& nodal_coordinates)
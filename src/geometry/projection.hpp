@@ -9,5 +9,9 @@ namespace neon::geometry
 {
 matrix2x project_to_plane(matrix3x const& nodal_coordinates);
 
+/// Project the \p nodal_coordinates onto their plane into \p plane_coordinates,
+/// which reuses the storage of \p plane_coordinates when the size is unchanged
+void project_to_plane(matrix2x& plane_coordinates, matrix3x const& nodal_coordinates);
+
 vector3 unit_outward_normal(matrix3x const& nodal_coordinates);
 }
@@ -0,0 +1,54 @@
+
+#include "graph/element_colouring.hpp"
+#include "graph/node_to_element.hpp"
+
+namespace neon
+{
+element_colouring::element_colouring(indices const& node_indices)
+{
+    auto const elements = node_indices.cols();
+    auto const nodes_per_element = node_indices.rows();
+
+    if (node_indices.size() == 0) return;
+
+    node_to_element const node_elements(node_indices,
+                                        static_cast<index_type>(node_indices.maxCoeff()) + 1);
+
+    std::vector<std::int32_t> element_colours(elements, -1);
+
+    // Stores the last element which marked a colour as used by a neighbour,
+    // avoiding the need to clear the list for each element
+    std::vector<index_type> marker;
+
+    for (index_type element{0}; element < elements; ++element)
+    {
+        for (index_type node{0}; node < nodes_per_element; ++node)
+        {
+            auto const node_index = node_indices(node, element);
+
+            for (auto it = node_elements.begin(node_index); it != node_elements.end(node_index); ++it)
+            {
+                auto const neighbour_colour = element_colours[*it];
+
+                if (neighbour_colour >= 0) marker[neighbour_colour] = element;
+            }
+        }
+
+        // Select the first colour not used by a neighbouring element
+        std::int32_t colour{0};
+        while (colour < static_cast<std::int32_t>(marker.size()) && marker[colour] == element)
+        {
+            ++colour;
+        }
+
+        if (colour == static_cast<std::int32_t>(marker.size()))
+        {
+            marker.push_back(-1);
+            m_colours.emplace_back();
+        }
+
+        element_colours[element] = colour;
+        m_colours[colour].push_back(element);
+    }
+}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+/// @file
+
+#include "numeric/index_types.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace neon
+{
+/// element_colouring partitions the elements of a mesh into groups (colours)
+/// such that no two elements of the same colour share a node.  The elements
+/// inside a colour can then be assembled concurrently into a global matrix
+/// or vector without atomic operations, since no two threads can write to
+/// the same degree of freedom.
+///
+/// A greedy first-fit colouring is performed over the elements in their
+/// natural order.  The colouring, and therefore the order of the floating
+/// point summation during assembly, is deterministic from run to run.
+class element_colouring
+{
+public:
+    using index_type = std::int64_t;
+
+public:
+    /// Compute the colouring from the nodal connectivity where each column
+    /// is an element and the rows are the element nodes
+    explicit element_colouring(indices const& node_indices);
+
+    /// \return the number of colours required to separate the elements
+    [[nodiscard]] auto colours() const noexcept -> std::size_t { return m_colours.size(); }
+
+    /// \return the list of elements with the given colour
+    [[nodiscard]] auto elements(std::size_t const colour) const noexcept
+        -> std::vector<index_type> const&
+    {
+        return m_colours[colour];
+    }
+
+    /// Evaluate \p function for each element.  The colours are processed in
+    /// sequence and the elements of each colour are processed in parallel.
+    /// \param function A callable type that accepts an element index
+    template <typename Callable>
+    void parallel_for(Callable&& function) const
+    {
+        for (auto const& colour : m_colours)
+        {
+            tbb::parallel_for(std::size_t{0}, colour.size(), [&](auto const index) {
+                function(colour[index]);
+            });
+        }
+    }
+
+    /// Evaluate \p function for batches of at most \p batch_size elements of
+    /// the same colour.  The colours are processed in sequence and the batches
+    /// of each colour are processed in parallel.
+    /// \param function A callable type that accepts a pointer to the element
+    /// indices of a batch and the number of elements in the batch
+    template <typename Callable>
+    void parallel_for_batch(std::int64_t const batch_size, Callable&& function) const
+    {
+        for (auto const& colour : m_colours)
+        {
+            auto const size = static_cast<std::int64_t>(colour.size());
+
+            tbb::parallel_for(std::int64_t{0},
+                              (size + batch_size - 1) / batch_size,
+                              [&](auto const batch) {
+                                  auto const first = batch * batch_size;
+
+                                  function(colour.data() + first,
+                                           std::min(batch_size, size - first));
+                              });
+        }
+    }
+
+protected:
+    /// Elements grouped by colour
+    std::vector<std::vector<index_type>> m_colours;
+};
+
+/// Compute the element colouring for each submesh in \p mesh
+/// \return a colouring for each submesh in the same order as mesh.meshes()
+template <typename MeshType>
+[[nodiscard]] auto colour_elements(MeshType const& mesh) -> std::vector<element_colouring>
+{
+    std::vector<element_colouring> colourings;
+    colourings.reserve(mesh.meshes().size());
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        colourings.emplace_back(submesh.all_node_indices());
+    }
+    return colourings;
+}
+
+/// Compute the element colouring for each natural boundary mesh in \p mesh
+/// \return a colouring for each boundary mesh in the order of the nonfollower
+/// boundaries and their natural interfaces
+template <typename MeshType>
+[[nodiscard]] auto colour_boundary_elements(MeshType const& mesh)
+    -> std::vector<element_colouring>
+{
+    std::vector<element_colouring> colourings;
+
+    for (auto const& [name, boundaries] : mesh.nonfollower_boundaries())
+    {
+        for (auto const& boundary : boundaries.natural_interface())
+        {
+            std::visit(
+                [&](auto const& boundary_mesh) {
+                    colourings.emplace_back(boundary_mesh.all_node_indices());
+                },
+                boundary);
+        }
+    }
+    return colourings;
+}
+}
@@ -0,0 +1,27 @@
+
+#include "graph/node_to_element.hpp"
+
+#include <numeric>
+
+namespace neon
+{
+node_to_element::node_to_element(indices const& node_indices, index_type const nodes)
+    : m_offsets(nodes + 1, 0), m_elements(node_indices.size())
+{
+    for (index_type index{0}; index < node_indices.size(); ++index)
+    {
+        ++m_offsets[node_indices.data()[index] + 1];
+    }
+    std::partial_sum(std::begin(m_offsets), std::end(m_offsets), std::begin(m_offsets));
+
+    auto position = m_offsets;
+
+    for (index_type element{0}; element < node_indices.cols(); ++element)
+    {
+        for (index_type node{0}; node < node_indices.rows(); ++node)
+        {
+            m_elements[position[node_indices(node, element)]++] = element;
+        }
+    }
+}
+}
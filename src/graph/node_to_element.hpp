@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file
+
+#include "numeric/index_types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace neon
+{
+/// node_to_element is the inverse of the element connectivity and stores the
+/// elements connected to each node in a compressed (offset and list) format.
+class node_to_element
+{
+public:
+    using index_type = std::int64_t;
+
+public:
+    /// Compute the inverse connectivity where each column of \p node_indices
+    /// is an element and the rows are the element nodes
+    /// \param nodes Number of nodes, which must exceed the largest node index
+    explicit node_to_element(indices const& node_indices, index_type const nodes);
+
+    /// \return the number of nodes
+    [[nodiscard]] auto nodes() const noexcept -> index_type { return m_offsets.size() - 1; }
+
+    /// \return pointer to the first element connected to \p node
+    [[nodiscard]] auto begin(index_type const node) const noexcept -> index_type const*
+    {
+        return m_elements.data() + m_offsets[node];
+    }
+
+    /// \return pointer to one past the last element connected to \p node
+    [[nodiscard]] auto end(index_type const node) const noexcept -> index_type const*
+    {
+        return m_elements.data() + m_offsets[node + 1];
+    }
+
+protected:
+    /// Position in the element list of the first element of each node
+    std::vector<index_type> m_offsets;
+    /// Elements for each node stored contiguously
+    std::vector<index_type> m_elements;
+};
+}
@@ -54,6 +54,9 @@ public:
         return node_indices(Eigen::all, element);
     }
 
+    /// \return the nodal connectivity where each column is an element
+    [[nodiscard]] auto all_node_indices() const noexcept -> indices const& { return node_indices; }
+
 protected:
     /// Indices for the nodal coordinates
     indices node_indices;
@@ -82,6 +85,7 @@ public:
         : neumann(node_indices, dof_indices, coordinates, time_history, load_history),
           sf(std::move(sf))
     {
+        integrate_reference_loads();
     }
 
     explicit surface_load(std::unique_ptr<surface_interpolation>&& sf,
@@ -94,6 +98,7 @@ public:
         : neumann(node_indices, dof_indices, coordinates, boundary, name, generate_time_step),
           sf(std::move(sf))
     {
+        integrate_reference_loads();
     }
 
     virtual ~surface_load() = default;
@@ -109,24 +114,36 @@ public:
     virtual std::pair<index_view, vector> external_force(std::int64_t const element,
                                                          double const load_factor) const override
     {
-        auto const node_view = node_indices(Eigen::all, element);
+        return {dof_indices(Eigen::all, element),
+                interpolate_prescribed_load(load_factor) * reference_loads.col(element)};
+    }
 
-        matrix3x const& X = coordinates->initial_configuration(node_view);
+protected:
+    /// Integrate the shape functions over each element in the initial
+    /// configuration, which is independent of the load factor
+    void integrate_reference_loads()
+    {
+        reference_loads.resize(node_indices.rows(), elements());
 
-        // Perform the computation of the external load vector
-        auto const f_ext = sf->quadrature().integrate(vector::Zero(X.cols()).eval(),
-                                                      [&](auto const& femval, auto) -> vector {
-                                                          auto const& [N, dN] = femval;
+        for (std::int64_t element{0}; element < elements(); ++element)
+        {
+            matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
 
-                                                          return N * jacobian_determinant(X * dN);
-                                                      });
+            reference_loads.col(element) = sf->quadrature().integrate(
+                vector::Zero(X.cols()).eval(), [&](auto const& femval, auto) -> vector {
+                    auto const& [N, dN] = femval;
 
-        return {dof_indices(Eigen::all, element), interpolate_prescribed_load(load_factor) * f_ext};
+                    return N * jacobian_determinant(X * dN);
+                });
+        }
     }
 
 protected:
     /// Shape function for surface interpolation
     std::unique_ptr<surface_interpolation> sf;
+
+    /// Element load vector for a unit load in each column
+    col_matrix reference_loads;
 };
 
 /// volume_load provides an interface for computing the contribution to the
@@ -148,6 +165,7 @@ public:
         : neumann(node_indices, dof_indices, coordinates, time_history, load_history),
           sf(std::move(sf))
     {
+        integrate_reference_loads();
     }
 
     explicit volume_load(std::unique_ptr<volume_interpolation>&& sf,
@@ -160,6 +178,7 @@ public:
         : neumann(node_indices, dof_indices, coordinates, boundary, name, generate_time_step),
           sf(std::move(sf))
     {
+        integrate_reference_loads();
     }
 
     virtual ~volume_load() = default;
@@ -171,22 +190,34 @@ public:
     virtual std::pair<index_view, vector> external_force(std::int64_t const element,
                                                          double const load_factor) const override
     {
-        auto const node_view = node_indices(Eigen::all, element);
+        return {dof_indices(Eigen::all, element),
+                interpolate_prescribed_load(load_factor) * reference_loads.col(element)};
+    }
 
-        matrix3x const& X = coordinates->initial_configuration(node_view);
+protected:
+    /// Integrate the shape functions over each element in the initial
+    /// configuration, which is independent of the load factor
+    void integrate_reference_loads()
+    {
+        reference_loads.resize(node_indices.rows(), elements());
 
-        // Perform the computation of the external load vector
-        auto const f_ext = sf->quadrature().integrate(vector::Zero(X.cols()).eval(),
-                                                      [&](auto const& femval, auto) -> vector {
-                                                          auto const& [N, dN] = femval;
+        for (std::int64_t element{0}; element < elements(); ++element)
+        {
+            matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
 
-                                                          return N * jacobian_determinant(X * dN);
-                                                      });
+            reference_loads.col(element) = sf->quadrature().integrate(
+                vector::Zero(X.cols()).eval(), [&](auto const& femval, auto) -> vector {
+                    auto const& [N, dN] = femval;
 
-        return {dof_indices(Eigen::all, element), interpolate_prescribed_load(load_factor) * f_ext};
+                    return N * jacobian_determinant(X * dN);
+                });
+        }
     }
 
 protected:
     std::unique_ptr<volume_interpolation> sf;
+
+    /// Element load vector for a unit load in each column
+    col_matrix reference_loads;
 };
 }
@@ -0,0 +1,30 @@
+
+#include "element_kernel.hpp"
+
+namespace neon::diffusion
+{
+std::unique_ptr<element_kernel> make_element_kernel(element_topology const topology,
+                                                    volume_quadrature const& quadrature)
+{
+    switch (topology)
+    {
+        case element_topology::tetrahedron4:
+            return std::make_unique<fixed_size_element_kernel<4>>(quadrature);
+        case element_topology::tetrahedron10:
+            return std::make_unique<fixed_size_element_kernel<10>>(quadrature);
+        case element_topology::prism6:
+            return std::make_unique<fixed_size_element_kernel<6>>(quadrature);
+        case element_topology::prism15:
+            return std::make_unique<fixed_size_element_kernel<15>>(quadrature);
+        case element_topology::hexahedron8:
+            return std::make_unique<fixed_size_element_kernel<8>>(quadrature);
+        case element_topology::hexahedron20:
+            return std::make_unique<fixed_size_element_kernel<20>>(quadrature);
+        case element_topology::hexahedron27:
+            return std::make_unique<fixed_size_element_kernel<27>>(quadrature);
+        default:
+            break;
+    }
+    return nullptr;
+}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file
+
+#include "mesh/element_topology.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "quadrature/numerical_quadrature.hpp"
+
+#include <memory>
+
+namespace neon::diffusion
+{
+/// element_kernel is the interface for the element routines of a scalar field
+/// (diffusion) discretisation of a three-dimensional volume.  Each routine
+/// operates on a single element where the conductivities are the contiguous
+/// quadrature point values of the element.
+class element_kernel
+{
+public:
+    virtual ~element_kernel() = default;
+
+    /**
+     * Compute the stiffness (conductivity) matrix \p k_e according to
+     * \f{align*}{
+     *     k &= \int_{\Omega_e} B^{T} \kappa B \, d\Omega
+     * \f}
+     * where \f$ B \f$ is the gradient of the shape functions
+     */
+    virtual void stiffness(matrix& k_e,
+                           matrix3x const& x,
+                           matrix3 const* conductivities) const = 0;
+
+    /**
+     * Compute the consistent mass matrix \p m_e according to
+     * \f{align*}{
+     *     m &= \int_{\Omega_e} N c N^{T} \, d\Omega
+     * \f}
+     * where \f$ c \f$ is the \p capacity (density times specific heat)
+     */
+    virtual void consistent_mass(matrix& m_e, matrix3x const& x, double const capacity) const = 0;
+};
+
+/// fixed_size_element_kernel implements the scalar field element routines for
+/// an element with \p Nodes nodes using matrices with sizes known at compile
+/// time.  The shape functions, the nodal coordinates and the element matrices
+/// are mapped onto the existing storage such that \f$ B^T \kappa B \f$ is
+/// unrolled without any dynamic temporaries.
+template <int Nodes>
+class fixed_size_element_kernel : public element_kernel
+{
+public:
+    using shape_type = Eigen::Matrix<double, Nodes, 1>;
+    using derivative_type = Eigen::Matrix<double, Nodes, 3>;
+    using gradient_type = Eigen::Matrix<double, 3, Nodes>;
+    using configuration_type = Eigen::Matrix<double, 3, Nodes>;
+    using element_matrix_type = Eigen::Matrix<double, Nodes, Nodes>;
+
+public:
+    /// Construct with the \p quadrature of the shape function, which must
+    /// outlive the kernel
+    explicit fixed_size_element_kernel(volume_quadrature const& quadrature)
+        : quadrature(quadrature)
+    {
+    }
+
+    void stiffness(matrix& k_e, matrix3x const& x, matrix3 const* conductivities) const override
+    {
+        k_e.resize(Nodes, Nodes);
+
+        Eigen::Map<element_matrix_type> k(k_e.data());
+
+        k.setZero();
+
+        Eigen::Map<configuration_type const> const x_e(x.data());
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            Eigen::Map<derivative_type const> const dN(std::get<1>(N_dN).data());
+
+            matrix3 const jacobian = x_e * dN;
+
+            gradient_type const B = (dN * jacobian.inverse()).transpose();
+
+            k.noalias() += B.transpose()
+                           * (conductivities[l] * B
+                              * (jacobian.determinant() * quadrature.weights()[l]));
+        });
+    }
+
+    void consistent_mass(matrix& m_e, matrix3x const& x, double const capacity) const override
+    {
+        m_e.resize(Nodes, Nodes);
+
+        Eigen::Map<element_matrix_type> m(m_e.data());
+
+        m.setZero();
+
+        Eigen::Map<configuration_type const> const x_e(x.data());
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            auto const& [N, dN] = N_dN;
+
+            Eigen::Map<shape_type const> const N_e(N.data());
+
+            matrix3 const jacobian = x_e * Eigen::Map<derivative_type const>(dN.data());
+
+            m.noalias() += (capacity * jacobian.determinant() * quadrature.weights()[l]) * N_e
+                           * N_e.transpose();
+        });
+    }
+
+private:
+    volume_quadrature const& quadrature;
+};
+
+/// Factory method for the fixed size scalar field volume element kernels
+/// \return kernel for the \p topology or nullptr if no kernel is available
+std::unique_ptr<element_kernel> make_element_kernel(element_topology const topology,
+                                                    volume_quadrature const& quadrature);
+}
@@ -38,14 +38,15 @@ std::pair<index_view, matrix> newton_convection::external_stiffness(std::int64_t
     matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
 
     // Perform the computation of the external element stiffness matrix
-    auto const k_ext = sf->quadrature().integrate(matrix::Zero(X.cols(), X.cols()).eval(),
-                                                  [&](auto const& femval, auto) -> matrix {
-                                                      auto const& [N, dN] = femval;
+    matrix k_ext = matrix::Zero(X.cols(), X.cols());
 
-                                                      auto const j = jacobian_determinant(X * dN);
+    sf->quadrature().accumulate(k_ext, [&](auto& k, auto const& femval, auto, auto const w) {
+        auto const& [N, dN] = femval;
 
-                                                      return N * N.transpose() * j;
-                                                  });
+        auto const j = jacobian_determinant(X * dN);
+
+        k.noalias() += (j * w) * N * N.transpose();
+    });
 
     return {local_dof_view(element),
             interpolate_prescribed_load(stiffness_time_data, load_factor) * k_ext};
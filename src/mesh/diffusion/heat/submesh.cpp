@@ -7,7 +7,6 @@
 #include "interpolations/interpolation_factory.hpp"
 #include "material/material_property.hpp"
 #include "mesh/material_coordinates.hpp"
-#include "numeric/gradient_operator.hpp"
 
 #include <cfenv>
 #include <omp.h>
@@ -25,7 +24,8 @@ submesh::submesh(json const& material_data,
       sf(make_volume_interpolation(topology(), mesh_data)),
       view(sf->quadrature().points()),
       variables(std::make_shared<internal_variables_t>(elements() * sf->quadrature().points())),
-      cm(make_constitutive_model(variables, material_data, mesh_data))
+      cm(make_constitutive_model(variables, material_data, mesh_data)),
+      kernel(make_element_kernel(topology(), sf->quadrature()))
 {
 }
 
@@ -41,67 +41,60 @@ void submesh::save_internal_variables(bool const have_converged)
     }
 }
 
-std::pair<index_view, matrix> submesh::tangent_stiffness(std::int64_t const element) const
+auto submesh::tangent_stiffness(std::int64_t const element) const
+    -> std::pair<index_view, matrix const&>
 {
-    auto const X = coordinates->current_configuration(local_node_view(element));
+    auto const& conductivities = variables->get(variable::second::conductivity);
 
-    auto const n = nodes_per_element();
+    thread_local matrix k_e;
 
-    auto const& D_Vec = variables->get(variable::second::conductivity);
+    kernel->stiffness(k_e,
+                      local_current_configuration(element),
+                      &conductivities[view(element, 0)]);
 
-    matrix const kmat = sf->quadrature()
-                            .integrate(matrix::Zero(n, n).eval(),
-                                       [&](auto const& femval, auto const& l) -> matrix {
-                                           auto const& [N, rhea] = femval;
-
-                                           auto const& D = D_Vec[view(element, l)];
+    return {local_dof_view(element), k_e};
+}
 
-                                           matrix3 const Jacobian = local_jacobian(rhea, X);
+auto submesh::consistent_mass(std::int64_t const element) const
+    -> std::pair<index_view, matrix const&>
+{
+    auto const density = cm->intrinsic_material().initial_density();
+    auto const specific_heat = cm->intrinsic_material().specific_heat();
 
-                                           // Compute the symmetric gradient operator
-                                           matrix const B = (rhea * Jacobian.inverse()).transpose();
+    thread_local matrix m_e;
 
-                                           return B.transpose() * D * B * Jacobian.determinant();
-                                       });
+    kernel->consistent_mass(m_e, local_current_configuration(element), density * specific_heat);
 
-    return {local_dof_view(element), kmat};
+    return {local_dof_view(element), m_e};
 }
 
-std::pair<index_view, matrix> submesh::consistent_mass(std::int64_t const element) const
+auto submesh::diagonal_mass(std::int64_t const element) const
+    -> std::pair<index_view, vector const&>
 {
-    auto const X = coordinates->current_configuration(local_node_view(element));
-
-    auto const density = cm->intrinsic_material().initial_density();
-    auto const specific_heat = cm->intrinsic_material().specific_heat();
+    auto const& [dofs, consistent_m] = this->consistent_mass(element);
 
-    auto m = sf->quadrature().integrate(matrix::Zero(nodes_per_element(), nodes_per_element()).eval(),
-                                        [&](auto const& femval, auto) -> matrix {
-                                            auto const& [N, dN] = femval;
+    thread_local vector diagonal_m;
 
-                                            matrix3 const Jacobian = local_jacobian(dN, X);
+    diagonal_m = consistent_m.rowwise().sum();
 
-                                            return N * density * specific_heat * N.transpose()
-                                                   * Jacobian.determinant();
-                                        });
-    return {local_dof_view(element), m};
+    return {dofs, diagonal_m};
 }
 
-std::pair<index_view, vector> submesh::diagonal_mass(std::int64_t const element) const
+auto submesh::local_current_configuration(std::int64_t const element) const -> matrix3x const&
 {
-    auto const& [dofs, consistent_m] = this->consistent_mass(element);
+    thread_local matrix3x x;
 
-    vector diagonal_m(consistent_m.rows());
-    for (auto i = 0; i < consistent_m.rows(); ++i)
-    {
-        diagonal_m(i) = consistent_m.row(i).sum();
-    }
-    return {local_dof_view(element), diagonal_m};
+    x = coordinates->current_configuration(local_node_view(element));
+
+    return x;
 }
 
 void submesh::update_internal_variables(double const time_step_size)
 {
     std::feclearexcept(FE_ALL_EXCEPT);
 
+    variables->advance();
+
     cm->update_internal_variables(time_step_size);
 
     if (std::fetestexcept(FE_INVALID))
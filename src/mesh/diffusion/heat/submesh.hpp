@@ -10,6 +10,7 @@
 #include "constitutive/internal_variables_alias.hpp"
 #include "interpolations/shape_function.hpp"
 #include "math/view.hpp"
+#include "mesh/diffusion/element_kernel.hpp"
 
 #include <memory>
 
@@ -55,7 +56,7 @@ public:
      * @return DoFs and stiffness matrix
      */
     [[nodiscard]] auto tangent_stiffness(std::int64_t const element) const
-        -> std::pair<index_view, matrix>;
+        -> std::pair<index_view, matrix const&>;
 
     /**
      * Compute the consistent (full) mass matrix according to
@@ -66,23 +67,15 @@ public:
      * @return DoFs and consistent mass matrix \sa diagonal_mass
      */
     [[nodiscard]] auto consistent_mass(std::int64_t const element) const
-        -> std::pair<index_view, matrix>;
+        -> std::pair<index_view, matrix const&>;
 
     /// \return Diagonal mass matrix using row sum technique \sa consistent_mass
     [[nodiscard]] auto diagonal_mass(std::int64_t const element) const
-        -> std::pair<index_view, vector>;
+        -> std::pair<index_view, vector const&>;
 
     /// Update the internal variables for the mesh group
     void update_internal_variables(double const time_step_size);
 
-    /// Compute the local Jacobian matrix \f$ \bf{x}_\xi \f$
-    /// \param rhea Shape function gradients at quadrature point
-    /// \param configuration Configuration of the element (coordinates)
-    auto local_jacobian(matrix const& rhea, matrix const& configuration) const -> matrix3
-    {
-        return configuration * rhea;
-    }
-
     ///
     [[nodiscard]] auto nodal_averaged_variable(variable::scalar const scalar_name) const
         -> std::pair<vector, vector>;
@@ -91,6 +84,12 @@ public:
     [[nodiscard]] auto nodal_averaged_variable(variable::second const tensor_name) const
         -> std::pair<vector, vector>;
 
+protected:
+    /// \return the current nodal coordinates of \p element gathered into
+    /// thread local storage, which avoids an allocation for each element
+    [[nodiscard]] auto local_current_configuration(std::int64_t const element) const
+        -> matrix3x const&;
+
 private:
     /// Nodal coordinates
     std::shared_ptr<material_coordinates> coordinates;
@@ -102,6 +101,8 @@ private:
 
     /// Constitutive model
     std::unique_ptr<constitutive_model> cm;
+    /// Fixed size element routines for the element topology
+    std::unique_ptr<element_kernel> kernel;
 };
 }
 }
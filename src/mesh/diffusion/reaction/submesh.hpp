@@ -10,6 +10,7 @@
 #include "constitutive/internal_variables_alias.hpp"
 #include "interpolations/shape_function.hpp"
 #include "math/view.hpp"
+#include "mesh/diffusion/element_kernel.hpp"
 
 #include <memory>
 
@@ -57,7 +58,7 @@ public:
      * @return DoFs and stiffness matrix
      */
     [[nodiscard]] auto tangent_stiffness(std::int64_t const element) const
-        -> std::pair<index_view, matrix>;
+        -> std::pair<index_view, matrix const&>;
 
     /**
      * Compute the consistent (full) mass matrix according to
@@ -67,10 +68,12 @@ public:
      * where \f$ \rho \f$ is the density and \f$ c_p \f$ is the specific heat
      * @return DoFs and consistent mass matrix \sa diagonal_mass
      */
-    [[nodiscard]] std::pair<index_view, matrix> consistent_mass(std::int64_t const element) const;
+    [[nodiscard]] auto consistent_mass(std::int64_t const element) const
+        -> std::pair<index_view, matrix const&>;
 
     /// \return diagonal mass matrix using row sum technique \sa consistent_mass
-    [[nodiscard]] std::pair<index_view, vector> diagonal_mass(std::int64_t const element) const;
+    [[nodiscard]] auto diagonal_mass(std::int64_t const element) const
+        -> std::pair<index_view, vector const&>;
 
     /// Update the internal variables for the mesh group
     void update_internal_variables(double const time_step_size);
@@ -83,6 +86,12 @@ public:
     [[nodiscard]] auto nodal_averaged_variable(variable::second const tensor_name) const
         -> std::pair<vector, vector>;
 
+protected:
+    /// \return the current nodal coordinates of \p element gathered into
+    /// thread local storage, which avoids an allocation for each element
+    [[nodiscard]] auto local_current_configuration(std::int64_t const element) const
+        -> matrix3x const&;
+
 private:
     /// Nodal coordinates
     std::shared_ptr<material_coordinates> coordinates;
@@ -95,6 +104,8 @@ private:
     std::shared_ptr<internal_variables_t> variables;
     /// Constitutive model
     std::unique_ptr<constitutive_model> cm;
+    /// Fixed size element routines for the element topology
+    std::unique_ptr<element_kernel> kernel;
 };
 }
 }
@@ -39,19 +39,22 @@ public:
     /// Assemble the element stiffness matrix for a given \p element
     /// \param element The element number to assemble.
     /// \return the tangent consistent stiffness matrix
-    auto tangent_stiffness(std::int64_t const element) const -> std::pair<index_view, matrix>
+    auto tangent_stiffness(std::int64_t const element) const
+        -> std::pair<index_view, matrix const&>
     {
         return static_cast<mesh_type*>(this)->tangent_stiffness(element);
     }
 
     /// \return the consistent mass matrix \sa diagonal_mass
-    auto consistent_mass(std::int64_t const element) const -> std::pair<index_view, matrix>
+    auto consistent_mass(std::int64_t const element) const
+        -> std::pair<index_view, matrix const&>
     {
         return static_cast<mesh_type*>(this)->consistent_mass(element);
     }
 
     /// \return the diagonal mass matrix as a vector \sa consistent_mass
-    auto diagonal_mass(std::int64_t const element) const -> std::pair<index_view, vector>
+    auto diagonal_mass(std::int64_t const element) const
+        -> std::pair<index_view, vector const&>
     {
         return static_cast<mesh_type*>(this)->diagonal_mass(element);
     }
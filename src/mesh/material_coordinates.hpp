@@ -27,6 +27,9 @@ public:
         return x(Eigen::all, local_nodes);
     }
 
+    /// \return current coordinates of every node
+    [[nodiscard]] auto current_coordinates() const noexcept -> matrix3x const& { return x; }
+
     /// \param u - displacement vector from initial configuration (x,y,z...)
     void update_current_configuration(vector const& u);
 
@@ -86,6 +86,7 @@ auto submesh::tangent_stiffness(std::int32_t const element) const -> matrix cons
 matrix const& submesh::bending_stiffness(matrix3x const& configuration, std::int32_t const element) const
 {
     static thread_local matrix2x B_bending(2, 6 * sf->number_of_nodes());
+    static thread_local matrix2x DB_bending(2, 6 * sf->number_of_nodes());
     static thread_local matrix k_bending(6 * sf->number_of_nodes(), 6 * sf->number_of_nodes());
 
     B_bending.setZero();
@@ -93,26 +94,30 @@ matrix const& submesh::bending_stiffness(matrix3x const& configuration, std::int
 
     auto const& D_bending = variables->get(variable::second::bending_stiffness);
 
-    sf->quadrature().integrate_inplace(k_bending, [&, this](auto const& femval, auto const l) {
-        auto const& [N, dN] = femval;
+    sf->quadrature().accumulate(
+        k_bending, [&, this](auto& k, auto const& femval, auto const l, auto const w) {
+            auto const& [N, dN] = femval;
 
-        double const j = jacobian_determinant(configuration * dN);
+            double const j = jacobian_determinant(configuration * dN);
 
-        for (int i = 0; i < sf->number_of_nodes(); ++i)
-        {
-            auto const offset = i * 6;
+            for (int i = 0; i < sf->number_of_nodes(); ++i)
+            {
+                auto const offset = i * 6;
 
-            B_bending(0, 3 + offset) = B_bending(1, 4 + offset) = dN(i, l) / j;
-        }
+                B_bending(0, 3 + offset) = B_bending(1, 4 + offset) = dN(i, l) / j;
+            }
 
-        return B_bending.transpose() * D_bending.at(view(element, l)) * B_bending * j;
-    });
+            DB_bending.noalias() = D_bending.at(view(element, l)) * B_bending;
+
+            k.noalias() += (j * w) * B_bending.transpose() * DB_bending;
+        });
     return k_bending;
 }
 
 matrix const& submesh::shear_stiffness(matrix3x const& configuration, std::int32_t const element) const
 {
     static thread_local matrix2x B_shear(2, 6 * sf->number_of_nodes());
+    static thread_local matrix2x DB_shear(2, 6 * sf->number_of_nodes());
     static thread_local matrix k_shear(6 * sf->number_of_nodes(), 6 * sf->number_of_nodes());
 
     B_shear.setZero();
@@ -120,22 +125,25 @@ matrix const& submesh::shear_stiffness(matrix3x const& configuration, std::int32
 
     auto const& D_shear = variables->get(variable::second::shear_stiffness);
 
-    sf->quadrature().integrate_inplace(k_shear, [&, this](auto const& femval, auto const l) {
-        auto const& [N, dN] = femval;
+    sf->quadrature().accumulate(
+        k_shear, [&, this](auto& k, auto const& femval, auto const l, auto const w) {
+            auto const& [N, dN] = femval;
 
-        auto const j = jacobian_determinant(configuration * dN);
+            auto const j = jacobian_determinant(configuration * dN);
 
-        for (int i = 0; i < sf->number_of_nodes(); ++i)
-        {
-            auto const offset = i * 6;
+            for (int i = 0; i < sf->number_of_nodes(); ++i)
+            {
+                auto const offset = i * 6;
 
-            B_shear(0, 0 + offset) = B_shear(1, 1 + offset) = dN(i, l) / j;
+                B_shear(0, 0 + offset) = B_shear(1, 1 + offset) = dN(i, l) / j;
 
-            B_shear(0, 4 + offset) = -N(i, l);
-            B_shear(1, 3 + offset) = N(i, l);
-        }
-        return B_shear.transpose() * D_shear.at(view(element, l)) * B_shear * j;
-    });
+                B_shear(0, 4 + offset) = -N(i, l);
+                B_shear(1, 3 + offset) = N(i, l);
+            }
+            DB_shear.noalias() = D_shear.at(view(element, l)) * B_shear;
+
+            k.noalias() += (j * w) * B_shear.transpose() * DB_shear;
+        });
     return k_shear;
 }
 
@@ -147,22 +155,23 @@ matrix const& submesh::axial_stiffness(matrix3x const& configuration, std::int32
     B_axial.setZero();
     k_axial.setZero();
 
-    auto const D_axial = variables->get(variable::scalar::axial_stiffness);
+    auto const& D_axial = variables->get(variable::scalar::axial_stiffness);
 
-    sf->quadrature().integrate_inplace(k_axial, [&, this](auto const& femval, auto const l) {
-        auto const& [N, dN] = femval;
+    sf->quadrature().accumulate(
+        k_axial, [&, this](auto& k, auto const& femval, auto const l, auto const w) {
+            auto const& [N, dN] = femval;
 
-        auto const j = jacobian_determinant(configuration * dN);
+            auto const j = jacobian_determinant(configuration * dN);
 
-        for (int i = 0; i < sf->number_of_nodes(); ++i)
-        {
-            auto const offset = i * 6;
+            for (int i = 0; i < sf->number_of_nodes(); ++i)
+            {
+                auto const offset = i * 6;
 
-            B_axial(2 + offset) = dN(i, l) / j;
-        }
+                B_axial(2 + offset) = dN(i, l) / j;
+            }
 
-        return B_axial * D_axial.at(view(element, l)) * B_axial.transpose() * j;
-    });
+            k.noalias() += (D_axial.at(view(element, l)) * j * w) * B_axial * B_axial.transpose();
+        });
     return k_axial;
 }
 
@@ -175,22 +184,24 @@ matrix const& submesh::torsional_stiffness(matrix3x const& configuration,
     B_torsion.setZero();
     k_torsion.setZero();
 
-    auto const D_torsion = variables->get(variable::scalar::torsional_stiffness);
+    auto const& D_torsion = variables->get(variable::scalar::torsional_stiffness);
 
-    sf->quadrature().integrate_inplace(k_torsion, [&, this](auto const& femval, auto const l) {
-        auto const& [N, dN] = femval;
+    sf->quadrature().accumulate(
+        k_torsion, [&, this](auto& k, auto const& femval, auto const l, auto const w) {
+            auto const& [N, dN] = femval;
 
-        auto const j = jacobian_determinant(configuration * dN);
+            auto const j = jacobian_determinant(configuration * dN);
 
-        for (int i = 0; i < sf->number_of_nodes(); ++i)
-        {
-            auto const offset = i * 6;
+            for (int i = 0; i < sf->number_of_nodes(); ++i)
+            {
+                auto const offset = i * 6;
 
-            B_torsion(5 + offset) = dN(i, l) / j;
-        }
+                B_torsion(5 + offset) = dN(i, l) / j;
+            }
 
-        return B_torsion * D_torsion.at(view(element, l)) * B_torsion.transpose() * j;
-    });
+            k.noalias() += (D_torsion.at(view(element, l)) * j * w) * B_torsion
+                           * B_torsion.transpose();
+        });
     return k_torsion;
 }
 
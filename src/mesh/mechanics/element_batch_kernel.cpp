@@ -0,0 +1,38 @@
+
+#include "element_batch_kernel.hpp"
+
+namespace neon::mechanics
+{
+std::unique_ptr<element_batch_kernel> make_element_batch_kernel(element_topology const topology,
+                                                                volume_quadrature const& quadrature,
+                                                                bool const is_finite_deformation)
+{
+    switch (topology)
+    {
+        case element_topology::tetrahedron4:
+            return std::make_unique<fixed_size_element_batch_kernel<4>>(quadrature,
+                                                                        is_finite_deformation);
+        case element_topology::tetrahedron10:
+            return std::make_unique<fixed_size_element_batch_kernel<10>>(quadrature,
+                                                                         is_finite_deformation);
+        case element_topology::prism6:
+            return std::make_unique<fixed_size_element_batch_kernel<6>>(quadrature,
+                                                                        is_finite_deformation);
+        case element_topology::prism15:
+            return std::make_unique<fixed_size_element_batch_kernel<15>>(quadrature,
+                                                                         is_finite_deformation);
+        case element_topology::hexahedron8:
+            return std::make_unique<fixed_size_element_batch_kernel<8>>(quadrature,
+                                                                        is_finite_deformation);
+        case element_topology::hexahedron20:
+            return std::make_unique<fixed_size_element_batch_kernel<20>>(quadrature,
+                                                                         is_finite_deformation);
+        case element_topology::hexahedron27:
+            return std::make_unique<fixed_size_element_batch_kernel<27>>(quadrature,
+                                                                         is_finite_deformation);
+        default:
+            break;
+    }
+    return nullptr;
+}
+}
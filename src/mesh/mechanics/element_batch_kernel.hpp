@@ -0,0 +1,531 @@
+#pragma once
+
+/// @file
+
+#include "mesh/element_topology.hpp"
+#include "numeric/aligned_vector.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "numeric/packed_symmetric.hpp"
+#include "quadrature/numerical_quadrature.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace neon::mechanics
+{
+/// element_batch_kernel is the interface for the element routines of a three
+/// dimensional finite strain continuum discretisation evaluated for a batch of
+/// elements at once.  The element data is gathered into a structure of arrays
+/// layout where each lane of a SIMD register holds one element, such that the
+/// Jacobians, their inverses and determinants, and the gradient operators are
+/// computed for every element in the batch with the same instructions.
+class element_batch_kernel
+{
+public:
+    /// Number of elements in a batch, which fills an AVX-512 register or two
+    /// AVX registers of double precision values
+    static auto constexpr lanes = Eigen::internal::packet_traits<double>::size > 4 ? 8 : 4;
+
+    /// Elements in a batch where any unused lanes repeat the first element
+    struct batch
+    {
+        /// Number of elements in the batch
+        std::int64_t size;
+        /// Node indices of each element
+        std::array<std::int32_t const*, lanes> nodes;
+        /// Index of the first quadrature point of each element
+        std::array<std::int64_t, lanes> offsets;
+    };
+
+public:
+    virtual ~element_batch_kernel() = default;
+
+    /// Compute the displacement gradients \p H, the deformation gradients \p F
+    /// and their determinants \p F_det from the initial coordinates \p X and
+    /// the current coordinates \p x.  The inverse reference Jacobians are
+    /// computed from \p X unless \p reference_jacobian_inverses is non-empty
+    virtual void deformation_measures(batch const& elements,
+                                      matrix3x const& X,
+                                      matrix3x const& x,
+                                      aligned_vector<matrix3> const& reference_jacobian_inverses,
+                                      aligned_vector<matrix3>& H,
+                                      aligned_vector<matrix3>& F,
+                                      aligned_vector<double>& F_det) const = 0;
+
+    /// Compute the internal force \p f_int of each element
+    virtual void internal_force(std::array<vector, lanes>& f_int,
+                                batch const& elements,
+                                matrix3x const& x,
+                                aligned_vector<matrix3> const& cauchy_stresses) const = 0;
+
+    /// Compute the tangent stiffness matrix \p k_e of each element, where only
+    /// the upper triangle is computed when \p upper_only is set
+    virtual void tangent_stiffness(std::array<matrix, lanes>& k_e,
+                                   batch const& elements,
+                                   matrix3x const& x,
+                                   voigt_tensor_view<6> const tangent_operators,
+                                   aligned_vector<matrix3> const& cauchy_stresses,
+                                   bool const upper_only) const = 0;
+
+    /// Compute the tangent stiffness matrix \p k_e and the internal force
+    /// \p f_int of each element in a single pass over the quadrature points
+    virtual void tangent_stiffness_and_internal_force(
+        std::array<matrix, lanes>& k_e,
+        std::array<vector, lanes>& f_int,
+        batch const& elements,
+        matrix3x const& x,
+        voigt_tensor_view<6> const tangent_operators,
+        aligned_vector<matrix3> const& cauchy_stresses,
+        bool const upper_only) const = 0;
+};
+
+/// fixed_size_element_batch_kernel implements the batched element routines
+/// for an element with \p Nodes nodes.  Each second order tensor is stored as
+/// nine lane vectors in row major component order and each nodal quantity as
+/// a lanes by nodes matrix.
+template <int Nodes>
+class fixed_size_element_batch_kernel : public element_batch_kernel
+{
+public:
+    static auto constexpr local_dofs = Nodes * 3;
+
+    /// A scalar value for each lane
+    using lane_type = Eigen::Array<double, lanes, 1>;
+    /// Components of a second order tensor for each lane
+    using lane_tensor_type = Eigen::Array<double, lanes, 9>;
+    /// Components of a fourth order tensor in Voigt notation for each lane
+    using lane_voigt_type = Eigen::Array<double, lanes, 36>;
+    /// A nodal value for each lane
+    using lane_nodal_type = Eigen::Matrix<double, lanes, Nodes>;
+
+    using derivative_type = Eigen::Matrix<double, Nodes, 3>;
+
+public:
+    /// Construct with the \p quadrature of the shape function, which must
+    /// outlive the kernel, where the geometric stiffness is only included when
+    /// \p is_finite_deformation is set
+    explicit fixed_size_element_batch_kernel(volume_quadrature const& quadrature,
+                                             bool const is_finite_deformation)
+        : quadrature(quadrature), is_finite_deformation(is_finite_deformation)
+    {
+    }
+
+    void deformation_measures(batch const& elements,
+                              matrix3x const& X,
+                              matrix3x const& x,
+                              aligned_vector<matrix3> const& reference_jacobian_inverses,
+                              aligned_vector<matrix3>& H,
+                              aligned_vector<matrix3>& F,
+                              aligned_vector<double>& F_det) const override
+    {
+        auto const X_e = gather(elements, X);
+        auto const x_e = gather(elements, x);
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            Eigen::Map<derivative_type const> const dN(std::get<1>(N_dN).data());
+
+            lane_tensor_type const F_0 = jacobian(X_e, dN);
+
+            lane_tensor_type const F_0_inv = reference_jacobian_inverses.empty()
+                                                 ? inverse(F_0, determinant(F_0))
+                                                 : gather(elements, reference_jacobian_inverses, l);
+
+            lane_tensor_type const F_x = jacobian(x_e, dN);
+
+            lane_tensor_type const deformation_gradient = product(F_x, F_0_inv);
+            lane_tensor_type const displacement_gradient = product(F_x - F_0, F_0_inv);
+
+            lane_type const deformation_determinant = determinant(deformation_gradient);
+
+            for (std::int64_t lane{0}; lane < elements.size; ++lane)
+            {
+                auto const index = elements.offsets[lane] + l;
+
+                for (int i{0}; i < 3; ++i)
+                {
+                    for (int j{0}; j < 3; ++j)
+                    {
+                        H[index](i, j) = displacement_gradient(lane, 3 * i + j);
+                        F[index](i, j) = deformation_gradient(lane, 3 * i + j);
+                    }
+                }
+                F_det[index] = deformation_determinant(lane);
+            }
+        });
+    }
+
+    void internal_force(std::array<vector, lanes>& f_int,
+                        batch const& elements,
+                        matrix3x const& x,
+                        aligned_vector<matrix3> const& cauchy_stresses) const override
+    {
+        auto const x_e = gather(elements, x);
+
+        std::array<lane_nodal_type, 3> force;
+
+        for (auto& component : force) component.setZero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            Eigen::Map<derivative_type const> const dN(std::get<1>(N_dN).data());
+
+            auto const [L, factor] = spatial_gradient(x_e, dN, l);
+
+            add_internal_force(force, L, gather(elements, cauchy_stresses, l), factor);
+        });
+
+        scatter(f_int, force, elements.size);
+    }
+
+    void tangent_stiffness(std::array<matrix, lanes>& k_e,
+                           batch const& elements,
+                           matrix3x const& x,
+                           voigt_tensor_view<6> const tangent_operators,
+                           aligned_vector<matrix3> const& cauchy_stresses,
+                           bool const upper_only) const override
+    {
+        integrate_stiffness<false>(k_e,
+                                   nullptr,
+                                   elements,
+                                   x,
+                                   tangent_operators,
+                                   cauchy_stresses,
+                                   upper_only);
+    }
+
+    void tangent_stiffness_and_internal_force(std::array<matrix, lanes>& k_e,
+                                              std::array<vector, lanes>& f_int,
+                                              batch const& elements,
+                                              matrix3x const& x,
+                                              voigt_tensor_view<6> const tangent_operators,
+                                              aligned_vector<matrix3> const& cauchy_stresses,
+                                              bool const upper_only) const override
+    {
+        integrate_stiffness<true>(k_e,
+                                  &f_int,
+                                  elements,
+                                  x,
+                                  tangent_operators,
+                                  cauchy_stresses,
+                                  upper_only);
+    }
+
+private:
+    /// Gather the nodal \p coordinates of each element in the batch
+    static auto gather(batch const& elements, matrix3x const& coordinates)
+        -> std::array<lane_nodal_type, 3>
+    {
+        std::array<lane_nodal_type, 3> nodal_coordinates;
+
+        for (int lane{0}; lane < lanes; ++lane)
+        {
+            for (int a{0}; a < Nodes; ++a)
+            {
+                auto const node = elements.nodes[lane][a];
+
+                for (int i{0}; i < 3; ++i)
+                {
+                    nodal_coordinates[i](lane, a) = coordinates(i, node);
+                }
+            }
+        }
+        return nodal_coordinates;
+    }
+
+    /// Gather the second order \p tensors at quadrature point \p l
+    static auto gather(batch const& elements, aligned_vector<matrix3> const& tensors, int const l)
+        -> lane_tensor_type
+    {
+        lane_tensor_type lane_tensor;
+
+        for (int lane{0}; lane < lanes; ++lane)
+        {
+            matrix3 const& tensor = tensors[elements.offsets[lane] + l];
+
+            for (int i{0}; i < 3; ++i)
+            {
+                for (int j{0}; j < 3; ++j)
+                {
+                    lane_tensor(lane, 3 * i + j) = tensor(i, j);
+                }
+            }
+        }
+        return lane_tensor;
+    }
+
+    /// Gather the fourth order \p tensors in Voigt notation at quadrature point
+    /// \p l, which are unpacked if stored in the packed layout
+    static auto gather(batch const& elements, voigt_tensor_view<6> const tensors, int const l)
+        -> lane_voigt_type
+    {
+        lane_voigt_type lane_tensor;
+
+        for (int lane{0}; lane < lanes; ++lane)
+        {
+            matrix6 const tensor = tensors[elements.offsets[lane] + l];
+
+            for (int I{0}; I < 6; ++I)
+            {
+                for (int J{0}; J < 6; ++J)
+                {
+                    lane_tensor(lane, 6 * I + J) = tensor(I, J);
+                }
+            }
+        }
+        return lane_tensor;
+    }
+
+    /// Scatter the nodal \p force of the first \p size lanes into \p f_int
+    static void scatter(std::array<vector, lanes>& f_int,
+                        std::array<lane_nodal_type, 3> const& force,
+                        std::int64_t const size)
+    {
+        for (std::int64_t lane{0}; lane < size; ++lane)
+        {
+            f_int[lane].resize(local_dofs);
+
+            for (int a{0}; a < Nodes; ++a)
+            {
+                for (int i{0}; i < 3; ++i)
+                {
+                    f_int[lane](a * 3 + i) = force[i](lane, a);
+                }
+            }
+        }
+    }
+
+    /// \return the Jacobian of the mapping from the parent element to the
+    /// nodal coordinates \p x_e
+    static auto jacobian(std::array<lane_nodal_type, 3> const& x_e,
+                         Eigen::Map<derivative_type const> const& dN) -> lane_tensor_type
+    {
+        lane_tensor_type J;
+
+        for (int i{0}; i < 3; ++i)
+        {
+            J.template middleCols<3>(3 * i) = (x_e[i] * dN).array();
+        }
+        return J;
+    }
+
+    static auto determinant(lane_tensor_type const& A) -> lane_type
+    {
+        return A.col(0) * (A.col(4) * A.col(8) - A.col(5) * A.col(7))
+               - A.col(1) * (A.col(3) * A.col(8) - A.col(5) * A.col(6))
+               + A.col(2) * (A.col(3) * A.col(7) - A.col(4) * A.col(6));
+    }
+
+    static auto inverse(lane_tensor_type const& A, lane_type const& det) -> lane_tensor_type
+    {
+        lane_tensor_type A_inv;
+
+        A_inv.col(0) = A.col(4) * A.col(8) - A.col(5) * A.col(7);
+        A_inv.col(1) = A.col(2) * A.col(7) - A.col(1) * A.col(8);
+        A_inv.col(2) = A.col(1) * A.col(5) - A.col(2) * A.col(4);
+        A_inv.col(3) = A.col(5) * A.col(6) - A.col(3) * A.col(8);
+        A_inv.col(4) = A.col(0) * A.col(8) - A.col(2) * A.col(6);
+        A_inv.col(5) = A.col(2) * A.col(3) - A.col(0) * A.col(5);
+        A_inv.col(6) = A.col(3) * A.col(7) - A.col(4) * A.col(6);
+        A_inv.col(7) = A.col(1) * A.col(6) - A.col(0) * A.col(7);
+        A_inv.col(8) = A.col(0) * A.col(4) - A.col(1) * A.col(3);
+
+        return A_inv.colwise() / det;
+    }
+
+    static auto product(lane_tensor_type const& A, lane_tensor_type const& B) -> lane_tensor_type
+    {
+        lane_tensor_type C = lane_tensor_type::Zero();
+
+        for (int i{0}; i < 3; ++i)
+        {
+            for (int j{0}; j < 3; ++j)
+            {
+                for (int k{0}; k < 3; ++k)
+                {
+                    C.col(3 * i + j) += A.col(3 * i + k) * B.col(3 * k + j);
+                }
+            }
+        }
+        return C;
+    }
+
+    /// \return the gradient of the shape functions in the current configuration,
+    /// where each component is a lanes by nodes matrix, and the product of the
+    /// Jacobian determinant with the quadrature weight
+    auto spatial_gradient(std::array<lane_nodal_type, 3> const& x_e,
+                          Eigen::Map<derivative_type const> const& dN,
+                          int const l) const
+        -> std::pair<std::array<lane_nodal_type, 3>, lane_type>
+    {
+        lane_tensor_type const J = jacobian(x_e, dN);
+
+        lane_type const det = determinant(J);
+
+        lane_tensor_type const J_inv = inverse(J, det);
+
+        std::array<lane_nodal_type, 3> L;
+
+        for (int j{0}; j < 3; ++j)
+        {
+            L[j].noalias() = J_inv.col(j).matrix() * dN.col(0).transpose();
+            L[j].noalias() += J_inv.col(3 + j).matrix() * dN.col(1).transpose();
+            L[j].noalias() += J_inv.col(6 + j).matrix() * dN.col(2).transpose();
+        }
+        return {L, det * quadrature.weights()[l]};
+    }
+
+    static void add_internal_force(std::array<lane_nodal_type, 3>& force,
+                                   std::array<lane_nodal_type, 3> const& L,
+                                   lane_tensor_type const& cauchy_stress,
+                                   lane_type const& factor)
+    {
+        for (int i{0}; i < 3; ++i)
+        {
+            for (int j{0}; j < 3; ++j)
+            {
+                force[i].array() += L[j].array().colwise()
+                                    * (cauchy_stress.col(3 * j + i) * factor);
+            }
+        }
+    }
+
+    /// Accumulate the stiffness matrices and optionally the internal forces
+    /// into \p f_int when \p ComputeForce is set
+    template <bool ComputeForce>
+    void integrate_stiffness(std::array<matrix, lanes>& k_e,
+                             std::array<vector, lanes>* const f_int,
+                             batch const& elements,
+                             matrix3x const& x,
+                             voigt_tensor_view<6> const tangent_operators,
+                             aligned_vector<matrix3> const& cauchy_stresses,
+                             bool const upper_only) const
+    {
+        // Stiffness coefficients in row major order for each lane
+        thread_local Eigen::Array<double, lanes, Eigen::Dynamic> k;
+
+        k.setZero(lanes, local_dofs * local_dofs);
+
+        auto const x_e = gather(elements, x);
+
+        std::array<lane_nodal_type, 3> force;
+
+        for (auto& component : force) component.setZero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            Eigen::Map<derivative_type const> const dN(std::get<1>(N_dN).data());
+
+            auto const [L, factor] = spatial_gradient(x_e, dN, l);
+
+            lane_tensor_type const cauchy_stress = gather(elements, cauchy_stresses, l);
+
+            lane_voigt_type const D = gather(elements, tangent_operators, l);
+
+            if constexpr (ComputeForce)
+            {
+                add_internal_force(force, L, cauchy_stress, factor);
+            }
+
+            // Product of the tangent operator with the symmetric gradient
+            // operator for each row and displacement component
+            std::array<std::array<lane_nodal_type, 3>, 6> DB;
+
+            for (int I{0}; I < 6; ++I)
+            {
+                for (int m{0}; m < 3; ++m)
+                {
+                    DB[I][m].array() = L[gradient_components[m][0]].array().colwise()
+                                       * (D.col(6 * I + voigt_rows[m][0]) * factor);
+
+                    for (int t{1}; t < 3; ++t)
+                    {
+                        DB[I][m].array() += L[gradient_components[m][t]].array().colwise()
+                                            * (D.col(6 * I + voigt_rows[m][t]) * factor);
+                    }
+                }
+            }
+
+            // Stress weighted gradient for the geometric stiffness
+            std::array<lane_nodal_type, 3> SL;
+
+            if (is_finite_deformation)
+            {
+                for (int i{0}; i < 3; ++i)
+                {
+                    SL[i].array() = L[0].array().colwise() * (cauchy_stress.col(3 * i) * factor);
+
+                    for (int j{1}; j < 3; ++j)
+                    {
+                        SL[i].array() += L[j].array().colwise()
+                                         * (cauchy_stress.col(3 * i + j) * factor);
+                    }
+                }
+            }
+
+            for (int a{0}; a < Nodes; ++a)
+            {
+                for (int b{upper_only ? a : 0}; b < Nodes; ++b)
+                {
+                    lane_type geometric = lane_type::Zero();
+
+                    if (is_finite_deformation)
+                    {
+                        for (int i{0}; i < 3; ++i)
+                        {
+                            geometric += L[i].col(a).array() * SL[i].col(b).array();
+                        }
+                    }
+
+                    for (int i{0}; i < 3; ++i)
+                    {
+                        auto const p = a * 3 + i;
+
+                        for (int m{upper_only && a == b ? i : 0}; m < 3; ++m)
+                        {
+                            auto const q = b * 3 + m;
+
+                            auto kpq = k.col(p * local_dofs + q);
+
+                            for (int s{0}; s < 3; ++s)
+                            {
+                                kpq += L[gradient_components[i][s]].col(a).array()
+                                       * DB[voigt_rows[i][s]][m].col(b).array();
+                            }
+                            if (i == m) kpq += geometric;
+                        }
+                    }
+                }
+            }
+        });
+
+        for (std::int64_t lane{0}; lane < elements.size; ++lane)
+        {
+            k_e[lane].resize(local_dofs, local_dofs);
+
+            Eigen::Map<Eigen::Matrix<double, local_dofs * local_dofs, 1>>(k_e[lane].data())
+                = k.row(lane).transpose().matrix();
+        }
+
+        if constexpr (ComputeForce)
+        {
+            scatter(*f_int, force, elements.size);
+        }
+    }
+
+private:
+    /// Non-zero rows of the symmetric gradient operator for each displacement
+    /// component \sa neon::symmetric_gradient
+    static constexpr int voigt_rows[3][3] = {{0, 4, 5}, {1, 3, 5}, {2, 3, 4}};
+    /// Gradient component in each of the non-zero rows
+    static constexpr int gradient_components[3][3] = {{0, 2, 1}, {1, 2, 0}, {2, 1, 0}};
+
+    volume_quadrature const& quadrature;
+
+    bool is_finite_deformation;
+};
+
+/// Factory method for the batched volume element kernels
+/// \return kernel for the \p topology or nullptr if no kernel is available
+std::unique_ptr<element_batch_kernel> make_element_batch_kernel(element_topology const topology,
+                                                                volume_quadrature const& quadrature,
+                                                                bool const is_finite_deformation);
+}
@@ -0,0 +1,65 @@
+
+#include "element_kernel.hpp"
+
+namespace neon::mechanics
+{
+std::unique_ptr<element_kernel<3>> make_volume_element_kernel(element_topology const topology,
+                                                              volume_quadrature const& quadrature,
+                                                              bool const is_finite_deformation)
+{
+    switch (topology)
+    {
+        case element_topology::tetrahedron4:
+            return std::make_unique<fixed_size_element_kernel<4, 3>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::tetrahedron10:
+            return std::make_unique<fixed_size_element_kernel<10, 3>>(quadrature,
+                                                                      is_finite_deformation);
+        case element_topology::prism6:
+            return std::make_unique<fixed_size_element_kernel<6, 3>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::prism15:
+            return std::make_unique<fixed_size_element_kernel<15, 3>>(quadrature,
+                                                                      is_finite_deformation);
+        case element_topology::hexahedron8:
+            return std::make_unique<fixed_size_element_kernel<8, 3>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::hexahedron20:
+            return std::make_unique<fixed_size_element_kernel<20, 3>>(quadrature,
+                                                                      is_finite_deformation);
+        case element_topology::hexahedron27:
+            return std::make_unique<fixed_size_element_kernel<27, 3>>(quadrature,
+                                                                      is_finite_deformation);
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<element_kernel<2>> make_surface_element_kernel(element_topology const topology,
+                                                               surface_quadrature const& quadrature,
+                                                               bool const is_finite_deformation)
+{
+    switch (topology)
+    {
+        case element_topology::triangle3:
+            return std::make_unique<fixed_size_element_kernel<3, 2>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::triangle6:
+            return std::make_unique<fixed_size_element_kernel<6, 2>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::quadrilateral4:
+            return std::make_unique<fixed_size_element_kernel<4, 2>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::quadrilateral8:
+            return std::make_unique<fixed_size_element_kernel<8, 2>>(quadrature,
+                                                                     is_finite_deformation);
+        case element_topology::quadrilateral9:
+            return std::make_unique<fixed_size_element_kernel<9, 2>>(quadrature,
+                                                                     is_finite_deformation);
+        default:
+            break;
+    }
+    return nullptr;
+}
+}
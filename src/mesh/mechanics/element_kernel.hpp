@@ -0,0 +1,400 @@
+#pragma once
+
+/// @file
+
+#include "mesh/element_topology.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "numeric/packed_symmetric.hpp"
+#include "quadrature/numerical_quadrature.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace neon::mechanics
+{
+/// element_kernel is the interface for the element routines of a finite strain
+/// continuum discretisation in \p Dimension spatial dimensions.  Each routine
+/// operates on a single element where the tangent operators and the Cauchy
+/// stresses are the contiguous quadrature point values of the element.  The
+/// tangent operators are stored either as full matrices or packed to the upper
+/// triangle of a symmetric matrix, which is unpacked for each quadrature point.
+/// When every quadrature point of an element refers to the shared tangent
+/// operator of the constitutive model it is read once for the element.
+template <int Dimension>
+class element_kernel
+{
+public:
+    static_assert(Dimension == 2 || Dimension == 3, "Dimension must be two or three");
+
+    /// Size of the symmetric tensors in Voigt notation
+    static auto constexpr voigt_size = Dimension * (Dimension + 1) / 2;
+
+    using quadrature_type = std::conditional_t<Dimension == 3,
+                                               volume_quadrature,
+                                               surface_quadrature>;
+
+    using configuration_type = matrixdx<Dimension>;
+    using second_tensor_type = Eigen::Matrix<double, Dimension, Dimension>;
+    using fourth_tensor_type = Eigen::Matrix<double, voigt_size, voigt_size>;
+    using fourth_tensor_view = voigt_tensor_view<voigt_size>;
+
+public:
+    virtual ~element_kernel() = default;
+
+    /**
+     * Compute the tangent stiffness matrix \p k_e as the sum of the material
+     * and the geometric stiffness
+     * \f{align*}{
+     * k &= \int_{v} B^{T} D B \, dv + I \int_{v} \nabla N^{T} \sigma \nabla N \, dv
+     * \f}
+     * where only the upper triangle is computed when \p upper_only is set
+     */
+    virtual void tangent_stiffness(matrix& k_e,
+                                   configuration_type const& x,
+                                   fourth_tensor_view const tangent_operators,
+                                   second_tensor_type const* cauchy_stresses,
+                                   bool const upper_only) const = 0;
+
+    /// Compute the tangent stiffness matrix \p k_e and the internal force
+    /// \p f_int in a single pass over the quadrature points
+    virtual void tangent_stiffness_and_internal_force(matrix& k_e,
+                                                      vector& f_int,
+                                                      configuration_type const& x,
+                                                      fourth_tensor_view const tangent_operators,
+                                                      second_tensor_type const* cauchy_stresses,
+                                                      bool const upper_only) const = 0;
+
+    /// Compute the product of the tangent stiffness matrix with \p u
+    virtual void tangent_stiffness_product(vector& product,
+                                           vector const& u,
+                                           configuration_type const& x,
+                                           fourth_tensor_view const tangent_operators,
+                                           second_tensor_type const* cauchy_stresses) const = 0;
+
+    /// Compute the diagonal of the tangent stiffness matrix
+    virtual void tangent_stiffness_diagonal(vector& diagonal,
+                                            configuration_type const& x,
+                                            fourth_tensor_view const tangent_operators,
+                                            second_tensor_type const* cauchy_stresses) const = 0;
+
+    /// Compute the internal force \p f_int
+    virtual void internal_force(vector& f_int,
+                                configuration_type const& x,
+                                second_tensor_type const* cauchy_stresses) const = 0;
+};
+
+/// fixed_size_element_kernel implements the element routines for an element
+/// with \p Nodes nodes using matrices with sizes known at compile time.  The
+/// shape function derivatives, the nodal coordinates and the element results
+/// are mapped onto the existing storage such that the gradient operator
+/// products (for example \f$ B^T D B \f$) are unrolled and vectorised without
+/// any dynamic allocation or copies.
+template <int Nodes, int Dimension>
+class fixed_size_element_kernel : public element_kernel<Dimension>
+{
+public:
+    using base_type = element_kernel<Dimension>;
+
+    using typename base_type::configuration_type;
+    using typename base_type::fourth_tensor_type;
+    using typename base_type::fourth_tensor_view;
+    using typename base_type::quadrature_type;
+    using typename base_type::second_tensor_type;
+
+    static auto constexpr voigt_size = base_type::voigt_size;
+    static auto constexpr local_dofs = Nodes * Dimension;
+
+    using derivative_type = Eigen::Matrix<double, Nodes, Dimension>;
+    using gradient_type = Eigen::Matrix<double, Dimension, Nodes>;
+    using strain_operator_type = Eigen::Matrix<double, voigt_size, local_dofs>;
+    using stiffness_type = Eigen::Matrix<double, local_dofs, local_dofs, Eigen::RowMajor>;
+    using nodal_type = Eigen::Matrix<double, Nodes, Dimension, Eigen::RowMajor>;
+    using node_matrix_type = Eigen::Matrix<double, Nodes, Nodes>;
+    using node_vector_type = Eigen::Matrix<double, Nodes, 1>;
+
+public:
+    /// Construct with the \p quadrature of the shape function, which must
+    /// outlive the kernel, where the geometric stiffness is only included when
+    /// \p is_finite_deformation is set
+    explicit fixed_size_element_kernel(quadrature_type const& quadrature,
+                                       bool const is_finite_deformation)
+        : quadrature(quadrature), is_finite_deformation(is_finite_deformation)
+    {
+    }
+
+    void tangent_stiffness(matrix& k_e,
+                           configuration_type const& x,
+                           fourth_tensor_view const tangent_operators,
+                           second_tensor_type const* cauchy_stresses,
+                           bool const upper_only) const override
+    {
+        integrate_stiffness<false>(k_e, nullptr, x, tangent_operators, cauchy_stresses, upper_only);
+    }
+
+    void tangent_stiffness_and_internal_force(matrix& k_e,
+                                              vector& f_int,
+                                              configuration_type const& x,
+                                              fourth_tensor_view const tangent_operators,
+                                              second_tensor_type const* cauchy_stresses,
+                                              bool const upper_only) const override
+    {
+        f_int.setZero(local_dofs);
+
+        integrate_stiffness<true>(k_e,
+                                  f_int.data(),
+                                  x,
+                                  tangent_operators,
+                                  cauchy_stresses,
+                                  upper_only);
+    }
+
+    void tangent_stiffness_product(vector& product,
+                                   vector const& u,
+                                   configuration_type const& x,
+                                   fourth_tensor_view const tangent_operators,
+                                   second_tensor_type const* cauchy_stresses) const override
+    {
+        product.resize(local_dofs);
+
+        Eigen::Map<Eigen::Matrix<double, local_dofs, 1>> p(product.data());
+        Eigen::Map<Eigen::Matrix<double, local_dofs, 1> const> const u_e(u.data());
+
+        // Nodal layout of the degrees of freedom for the geometric contribution
+        Eigen::Map<nodal_type> P(product.data());
+        Eigen::Map<nodal_type const> const U(u.data());
+
+        p.setZero();
+
+        strain_operator_type B = strain_operator_type::Zero();
+
+        auto const* const shared = tangent_operators.shared_tensor(quadrature.points());
+
+        fourth_tensor_type D = shared ? *shared : fourth_tensor_type::Zero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            auto const [L, factor] = spatial_gradient(std::get<1>(N_dN), x, l);
+
+            symmetric_gradient(B, L);
+
+            Eigen::Matrix<double, voigt_size, 1> const strain = B * u_e;
+
+            if (!shared) D = tangent_operators[l];
+
+            p.noalias() += B.transpose() * (D * strain * factor);
+
+            if (is_finite_deformation)
+            {
+                second_tensor_type const gradient = L * U;
+
+                P.noalias() += L.transpose() * (cauchy_stresses[l] * gradient * factor);
+            }
+        });
+    }
+
+    void tangent_stiffness_diagonal(vector& diagonal,
+                                    configuration_type const& x,
+                                    fourth_tensor_view const tangent_operators,
+                                    second_tensor_type const* cauchy_stresses) const override
+    {
+        diagonal.resize(local_dofs);
+
+        Eigen::Map<Eigen::Matrix<double, local_dofs, 1>> d(diagonal.data());
+
+        d.setZero();
+
+        node_vector_type geometric_diagonal = node_vector_type::Zero();
+
+        strain_operator_type B = strain_operator_type::Zero();
+
+        auto const* const shared = tangent_operators.shared_tensor(quadrature.points());
+
+        fourth_tensor_type D = shared ? *shared : fourth_tensor_type::Zero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            auto const [L, factor] = spatial_gradient(std::get<1>(N_dN), x, l);
+
+            symmetric_gradient(B, L);
+
+            if (!shared) D = tangent_operators[l];
+
+            // Diagonal entries of B^T D B
+            d.noalias() += (D * B).cwiseProduct(B).colwise().sum().transpose() * factor;
+
+            if (is_finite_deformation)
+            {
+                geometric_diagonal.noalias() += (cauchy_stresses[l] * L)
+                                                    .cwiseProduct(L)
+                                                    .colwise()
+                                                    .sum()
+                                                    .transpose()
+                                                * factor;
+            }
+        });
+
+        // The geometric contribution is identical for each nodal degree of freedom
+        Eigen::Map<nodal_type>(diagonal.data()).colwise() += geometric_diagonal;
+    }
+
+    void internal_force(vector& f_int,
+                        configuration_type const& x,
+                        second_tensor_type const* cauchy_stresses) const override
+    {
+        f_int.resize(local_dofs);
+
+        Eigen::Map<nodal_type> F(f_int.data());
+
+        F.setZero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            auto const [L, factor] = spatial_gradient(std::get<1>(N_dN), x, l);
+
+            F.noalias() += L.transpose() * (cauchy_stresses[l] * factor);
+        });
+    }
+
+private:
+    /// \return the gradient of the shape functions in the current configuration
+    /// and the product of the Jacobian determinant with the quadrature weight
+    auto spatial_gradient(matrixxd<Dimension> const& dN,
+                          configuration_type const& x,
+                          std::int64_t const l) const -> std::pair<gradient_type, double>
+    {
+        Eigen::Map<derivative_type const> const dN_e(dN.data());
+        Eigen::Map<gradient_type const> const x_e(x.data());
+
+        second_tensor_type const jacobian = x_e * dN_e;
+
+        return {(dN_e * jacobian.inverse()).transpose(),
+                jacobian.determinant() * quadrature.weights()[l]};
+    }
+
+    /// Fill the non-zero entries of the symmetric gradient operator \p B
+    /// \sa neon::symmetric_gradient
+    static void symmetric_gradient(strain_operator_type& B, gradient_type const& L) noexcept
+    {
+        for (int a{0}; a < Nodes; ++a)
+        {
+            auto const b = a * Dimension;
+
+            if constexpr (Dimension == 3)
+            {
+                B(0, b) = L(0, a);
+                B(4, b) = L(2, a);
+                B(5, b) = L(1, a);
+                B(1, b + 1) = L(1, a);
+                B(3, b + 1) = L(2, a);
+                B(5, b + 1) = L(0, a);
+                B(2, b + 2) = L(2, a);
+                B(3, b + 2) = L(1, a);
+                B(4, b + 2) = L(0, a);
+            }
+            else
+            {
+                B(0, b) = L(0, a);
+                B(2, b) = L(1, a);
+                B(1, b + 1) = L(1, a);
+                B(2, b + 1) = L(0, a);
+            }
+        }
+    }
+
+    /// Accumulate the stiffness matrix and optionally the internal force into
+    /// \p force when \p ComputeForce is set
+    template <bool ComputeForce>
+    void integrate_stiffness(matrix& k_e,
+                             double* const force,
+                             configuration_type const& x,
+                             fourth_tensor_view const tangent_operators,
+                             second_tensor_type const* cauchy_stresses,
+                             bool const upper_only) const
+    {
+        k_e.resize(local_dofs, local_dofs);
+
+        Eigen::Map<stiffness_type> k(k_e.data());
+
+        k.setZero();
+
+        node_matrix_type k_geo = node_matrix_type::Zero();
+
+        strain_operator_type B = strain_operator_type::Zero();
+        strain_operator_type DB;
+
+        // Elements where every quadrature point refers to the shared tangent
+        // operator read it once
+        auto const* const shared = tangent_operators.shared_tensor(quadrature.points());
+
+        fourth_tensor_type D = shared ? *shared : fourth_tensor_type::Zero();
+
+        quadrature.for_each([&](auto const& N_dN, auto const l) {
+            auto const [L, factor] = spatial_gradient(std::get<1>(N_dN), x, l);
+
+            if constexpr (ComputeForce)
+            {
+                Eigen::Map<nodal_type>(force).noalias() += L.transpose()
+                                                           * (cauchy_stresses[l] * factor);
+            }
+
+            symmetric_gradient(B, L);
+
+            if (!shared) D = tangent_operators[l];
+
+            DB.noalias() = D * B * factor;
+
+            if (upper_only)
+            {
+                k.template triangularView<Eigen::Upper>() += B.transpose() * DB;
+            }
+            else
+            {
+                k.noalias() += B.transpose() * DB;
+            }
+
+            if (is_finite_deformation)
+            {
+                if (upper_only)
+                {
+                    k_geo.template triangularView<Eigen::Upper>() += L.transpose()
+                                                                     * (cauchy_stresses[l] * L
+                                                                        * factor);
+                }
+                else
+                {
+                    k_geo.noalias() += L.transpose() * (cauchy_stresses[l] * L * factor);
+                }
+            }
+        });
+
+        if (is_finite_deformation)
+        {
+            for (int a{0}; a < Nodes; ++a)
+            {
+                for (int b{upper_only ? a : 0}; b < Nodes; ++b)
+                {
+                    for (int i{0}; i < Dimension; ++i)
+                    {
+                        k(a * Dimension + i, b * Dimension + i) += k_geo(a, b);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    quadrature_type const& quadrature;
+
+    bool is_finite_deformation;
+};
+
+/// Factory method for the fixed size volume element kernels
+/// \return kernel for the \p topology or nullptr if no kernel is available
+std::unique_ptr<element_kernel<3>> make_volume_element_kernel(element_topology const topology,
+                                                              volume_quadrature const& quadrature,
+                                                              bool const is_finite_deformation);
+
+/// Factory method for the fixed size surface (plane) element kernels
+/// \return kernel for the \p topology or nullptr if no kernel is available
+std::unique_ptr<element_kernel<2>> make_surface_element_kernel(element_topology const topology,
+                                                               surface_quadrature const& quadrature,
+                                                               bool const is_finite_deformation);
+}
@@ -0,0 +1,52 @@
+
+#include "hourglass_control.hpp"
+
+#include "io/json.hpp"
+
+#include <stdexcept>
+
+namespace neon::mechanics
+{
+/// \return the hourglass coefficient from the element options
+static double hourglass_coefficient(json const& mesh_data)
+{
+    auto const& element_options = mesh_data["element_options"];
+
+    if (element_options.find("hourglass_coefficient") == end(element_options))
+    {
+        return 0.05;
+    }
+
+    auto const coefficient = element_options["hourglass_coefficient"].get<double>();
+
+    if (coefficient < 0.0)
+    {
+        throw std::domain_error("\"hourglass_coefficient\" must be non-negative");
+    }
+    return coefficient;
+}
+
+std::unique_ptr<hourglass_control<3>> make_hourglass_control(element_topology const topology,
+                                                             volume_quadrature const& quadrature,
+                                                             json const& mesh_data)
+{
+    if (topology != element_topology::hexahedron8 || quadrature.points() != 1) return nullptr;
+
+    auto const coefficient = hourglass_coefficient(mesh_data);
+
+    return coefficient > 0.0 ? std::make_unique<hourglass_control<3>>(quadrature, coefficient)
+                             : nullptr;
+}
+
+std::unique_ptr<hourglass_control<2>> make_hourglass_control(element_topology const topology,
+                                                             surface_quadrature const& quadrature,
+                                                             json const& mesh_data)
+{
+    if (topology != element_topology::quadrilateral4 || quadrature.points() != 1) return nullptr;
+
+    auto const coefficient = hourglass_coefficient(mesh_data);
+
+    return coefficient > 0.0 ? std::make_unique<hourglass_control<2>>(quadrature, coefficient)
+                             : nullptr;
+}
+}
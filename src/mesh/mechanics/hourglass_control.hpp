@@ -0,0 +1,192 @@
+#pragma once
+
+/// @file
+
+#include "io/json_forward.hpp"
+#include "mesh/element_topology.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "quadrature/numerical_quadrature.hpp"
+
+#include <Eigen/LU>
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace neon::mechanics
+{
+/// hourglass_control stabilises the zero energy modes of the linear
+/// hexahedron and quadrilateral evaluated with a single quadrature point.  This
+/// uses the stiffness form of Flanagan and Belytschko (1981), where the
+/// hourglass base vectors are projected to be orthogonal to the linear
+/// displacement fields in the reference configuration.  Rigid body motions
+/// and homogeneous deformations are then not resisted and an elastic stiffness
+/// acts only on the hourglass modes.  The stiffness is proportional to the
+/// shear modulus taken from the tangent operator at the quadrature point.
+template <int Dimension>
+class hourglass_control
+{
+public:
+    static_assert(Dimension == 2 || Dimension == 3, "Dimension must be two or three");
+
+    /// Nodes of the linear element
+    static auto constexpr nodes = Dimension == 3 ? 8 : 4;
+    /// Number of hourglass modes for each displacement component
+    static auto constexpr modes = Dimension == 3 ? 4 : 1;
+    /// Size of the symmetric tensors in Voigt notation
+    static auto constexpr voigt_size = Dimension * (Dimension + 1) / 2;
+
+    using quadrature_type = std::conditional_t<Dimension == 3,
+                                               volume_quadrature,
+                                               surface_quadrature>;
+
+    using configuration_type = matrixdx<Dimension>;
+    using fourth_tensor_type = Eigen::Matrix<double, voigt_size, voigt_size>;
+
+protected:
+    using derivative_type = Eigen::Matrix<double, nodes, Dimension>;
+    using nodal_type = Eigen::Matrix<double, Dimension, nodes>;
+    using mode_type = Eigen::Matrix<double, nodes, modes>;
+    using nodal_stiffness_type = Eigen::Matrix<double, nodes, nodes>;
+
+public:
+    /// \param quadrature One point quadrature rule of the element
+    /// \param coefficient Scaling of the hourglass stiffness
+    explicit hourglass_control(quadrature_type const& quadrature, double const coefficient)
+        : coefficient(coefficient)
+    {
+        quadrature.for_each([this](auto const& femval, auto) { dN = std::get<1>(femval); });
+    }
+
+    /// Add the hourglass stiffness to \p k_e, where only the upper triangle
+    /// is added when \p upper_only is set
+    void add_stiffness(matrix& k_e,
+                       configuration_type const& X,
+                       fourth_tensor_type const& tangent_operator,
+                       bool const upper_only) const
+    {
+        nodal_stiffness_type const K = stiffness(X, tangent_operator);
+
+        for (int a{0}; a < nodes; ++a)
+        {
+            for (int b{upper_only ? a : 0}; b < nodes; ++b)
+            {
+                for (int i{0}; i < Dimension; ++i)
+                {
+                    k_e(a * Dimension + i, b * Dimension + i) += K(a, b);
+                }
+            }
+        }
+    }
+
+    /// Add the hourglass force due to the displacement from the reference
+    /// configuration \p X to the current configuration \p x to \p f_int
+    void add_internal_force(vector& f_int,
+                            configuration_type const& X,
+                            configuration_type const& x,
+                            fourth_tensor_type const& tangent_operator) const
+    {
+        nodal_type const u = x - X;
+
+        Eigen::Map<nodal_type>(f_int.data()) += u * stiffness(X, tangent_operator);
+    }
+
+    /// Add the product of the hourglass stiffness and \p u to \p product
+    void add_stiffness_product(vector& product,
+                               vector const& u,
+                               configuration_type const& X,
+                               fourth_tensor_type const& tangent_operator) const
+    {
+        Eigen::Map<nodal_type>(product.data()) += Eigen::Map<nodal_type const>(u.data())
+                                                  * stiffness(X, tangent_operator);
+    }
+
+    /// Add the diagonal of the hourglass stiffness to \p diagonal
+    void add_stiffness_diagonal(vector& diagonal,
+                                configuration_type const& X,
+                                fourth_tensor_type const& tangent_operator) const
+    {
+        nodal_stiffness_type const K = stiffness(X, tangent_operator);
+
+        for (int a{0}; a < nodes; ++a)
+        {
+            diagonal.segment<Dimension>(a * Dimension).array() += K(a, a);
+        }
+    }
+
+protected:
+    /// \return the hourglass stiffness between the nodes, which is the same
+    /// for each displacement component
+    auto stiffness(configuration_type const& X, fourth_tensor_type const& tangent_operator) const
+        -> nodal_stiffness_type
+    {
+        nodal_type const X_e = X;
+
+        Eigen::Matrix<double, Dimension, Dimension> const jacobian = X_e * dN;
+
+        // Gradient operator at the element centre
+        derivative_type const b = dN * jacobian.inverse();
+
+        // Project out the linear displacement fields from the base vectors
+        mode_type const gamma = base_vectors() - b * (X_e * base_vectors());
+
+        // Volume of the element from the weight of the single quadrature point
+        double const volume = jacobian.determinant() * (1 << Dimension);
+
+        // Average of the shear terms in the tangent operator
+        double const shear_modulus = tangent_operator.diagonal()
+                                         .template tail<voigt_size - Dimension>()
+                                         .mean();
+
+        return coefficient * shear_modulus * volume * b.squaredNorm() / nodes * gamma
+               * gamma.transpose();
+    }
+
+    /// \return the hourglass base vectors as the products of the natural
+    /// coordinates of the nodes
+    static auto base_vectors() -> mode_type const&
+    {
+        static mode_type const h = [] {
+            mode_type h;
+            if constexpr (Dimension == 3)
+            {
+                h << 1.0, 1.0, 1.0, -1.0,   //
+                    -1.0, 1.0, -1.0, 1.0,   //
+                    1.0, -1.0, -1.0, -1.0,  //
+                    -1.0, -1.0, 1.0, 1.0,   //
+                    1.0, -1.0, -1.0, 1.0,   //
+                    -1.0, -1.0, 1.0, -1.0,  //
+                    1.0, 1.0, 1.0, 1.0,     //
+                    -1.0, 1.0, -1.0, -1.0;
+            }
+            else
+            {
+                h << 1.0, -1.0, 1.0, -1.0;
+            }
+            return h;
+        }();
+        return h;
+    }
+
+protected:
+    /// Shape function derivatives at the quadrature point
+    derivative_type dN;
+
+    /// Scaling of the hourglass stiffness
+    double coefficient;
+};
+
+/// \return hourglass stabilisation if the element \p topology has zero energy
+/// modes under the \p quadrature rule, otherwise nullptr.  The coefficient is
+/// read from the element options in \p mesh_data and a zero coefficient
+/// disables the stabilisation.
+std::unique_ptr<hourglass_control<3>> make_hourglass_control(element_topology const topology,
+                                                             volume_quadrature const& quadrature,
+                                                             json const& mesh_data);
+
+/// \sa make_hourglass_control
+std::unique_ptr<hourglass_control<2>> make_hourglass_control(element_topology const topology,
+                                                             surface_quadrature const& quadrature,
+                                                             json const& mesh_data);
+}
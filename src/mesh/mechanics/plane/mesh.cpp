@@ -3,6 +3,7 @@
 
 #include "mesh/basic_mesh.hpp"
 #include "mesh/dof_allocator.hpp"
+#include "material/material_property.hpp"
 #include "io/json.hpp"
 #include "io/post/variable_string_adapter.hpp"
 #include "io/post/node_averaged_variables.hpp"
@@ -38,6 +39,13 @@ mesh::mesh(basic_mesh const& basic_mesh,
     {
         submeshes.emplace_back(material_data, simulation_data, coordinates, submesh);
 
+        auto const& variables = submeshes.back().internal_variables();
+
+        std::cout << std::string(4, ' ') << "Internal variables for material \""
+                  << submeshes.back().constitutive().intrinsic_material().name() << "\" use "
+                  << variables.allocated_bytes() / 1.0e6 << " MB with "
+                  << variables.history_bytes() / 1.0e6 << " MB of history\n";
+
         writer->mesh(submesh.all_node_indices(), submesh.topology());
     }
     allocate_boundary_conditions(simulation_data, basic_mesh);
@@ -70,6 +78,23 @@ void mesh::update_internal_variables(vector const& u, double const time_step_siz
               << "s\n";
 }
 
+void mesh::update_stress(vector const& u, double const time_step_size)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    coordinates->update_current_xy_configuration(u);
+
+    for (auto& submesh : submeshes)
+    {
+        submesh.update_stress(time_step_size);
+    }
+
+    auto const end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> const elapsed_seconds = end - start;
+
+    std::cout << std::string(6, ' ') << "Stress update took " << elapsed_seconds.count() << "s\n";
+}
+
 void mesh::save_internal_variables(bool const have_converged)
 {
     for (auto& submesh : submeshes)
@@ -78,6 +103,16 @@ void mesh::save_internal_variables(bool const have_converged)
     }
 }
 
+void mesh::checkpoint_internal_variables()
+{
+    for (auto& submesh : submeshes) submesh.checkpoint_internal_variables();
+}
+
+void mesh::restore_internal_variables()
+{
+    for (auto& submesh : submeshes) submesh.restore_internal_variables();
+}
+
 bool mesh::is_nonfollower_load(std::string const& boundary_type) const
 {
     return boundary_type == "traction" || boundary_type == "pressure"
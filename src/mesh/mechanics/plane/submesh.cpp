@@ -28,7 +28,11 @@ submesh::submesh(json const& material_data,
       sf(make_surface_interpolation(topology(), simulation_data)),
       view(sf->quadrature().points()),
       variables(std::make_shared<internal_variables_t>(elements() * sf->quadrature().points())),
-      cm(make_constitutive_model(variables, material_data, simulation_data))
+      cm(make_constitutive_model(variables, material_data, simulation_data)),
+      kernel(make_surface_element_kernel(topology(),
+                                         sf->quadrature(),
+                                         cm->is_finite_deformation())),
+      hourglass(make_hourglass_control(topology(), sf->quadrature(), simulation_data))
 {
     // Allocate storage for the displacement gradient
     variables->add(variable::second::displacement_gradient,
@@ -42,9 +46,27 @@ submesh::submesh(json const& material_data,
         F = matrix2::Identity();
     }
 
+    // The kinematics and the stress are computed at every update and do not
+    // start from the converged values
+    variables->mark_recomputed(variable::second::displacement_gradient,
+                               variable::second::deformation_gradient,
+                               variable::second::cauchy_stress);
+    variables->mark_recomputed(variable::scalar::DetF);
+
     variables->commit();
 
     dof_allocator(node_indices, dof_list, traits::dofs_per_node);
+
+    auto const& element_options = simulation_data["element_options"];
+
+    // Elastic quadrature points refer to the tangent operator of the model
+    if (auto const* const shared_tangent = cm->shared_tangent();
+        shared_tangent
+        && (element_options.find("shared_tangent") == end(element_options)
+            || element_options["shared_tangent"].get<bool>()))
+    {
+        variables->share(variable::fourth::tangent_operator, *shared_tangent);
+    }
 }
 
 void submesh::save_internal_variables(bool const have_converged)
@@ -59,103 +81,198 @@ void submesh::save_internal_variables(bool const have_converged)
     }
 }
 
+void submesh::checkpoint_internal_variables() { variables->checkpoint(); }
+
+void submesh::restore_internal_variables() { variables->restore(); }
+
 auto submesh::tangent_stiffness(std::int32_t const element) const -> matrix const&
 {
-    auto const x = geometry::project_to_plane(
-        coordinates->current_configuration(local_node_view(element)));
+    matrix2x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
     thread_local matrix k_e;
 
-    k_e = material_tangent_stiffness(x, element);
+    kernel->tangent_stiffness(k_e, x, tangent_operators.offset(l), &cauchy_stresses[l], false);
 
-    if (cm->is_finite_deformation())
+    if (hourglass)
     {
-        k_e.noalias() += geometric_tangent_stiffness(x, element);
+        hourglass->add_stiffness(k_e,
+                                 local_initial_configuration(element),
+                                 tangent_operators[l],
+                                 false);
     }
     return k_e;
 }
 
-auto submesh::internal_force(std::int32_t const element) const -> vector const&
+auto submesh::symmetric_tangent_stiffness(std::int32_t const element) const -> matrix const&
 {
-    thread_local vector f_int(nodes_per_element() * dofs_per_node());
+    matrix2x const& x = local_current_configuration(element);
 
-    f_int.setZero();
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-    auto const x = geometry::project_to_plane(
-        coordinates->current_configuration(local_node_view(element)));
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    thread_local matrix k_e;
+
+    kernel->tangent_stiffness(k_e, x, tangent_operators.offset(l), &cauchy_stresses[l], true);
+
+    if (hourglass)
+    {
+        hourglass->add_stiffness(k_e,
+                                 local_initial_configuration(element),
+                                 tangent_operators[l],
+                                 true);
+    }
+    return k_e;
+}
 
-    sf->quadrature()
-        .integrate_inplace(Eigen::Map<row_matrix>(f_int.data(), nodes_per_element(), dofs_per_node()),
-                           [&](auto const& N_dN, auto const index) {
-                               auto const& [N, dN] = N_dN;
+auto submesh::tangent_stiffness_and_internal_force(std::int32_t const element,
+                                                   bool const upper_only) const
+    -> std::pair<matrix const&, vector const&>
+{
+    matrix2x const& x = local_current_configuration(element);
 
-                               matrix2 const Jacobian = local_deformation_gradient(dN, x);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-                               matrix2 const& cauchy_stress = cauchy_stresses[view(element, index)];
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-                               // symmetric gradient operator
-                               auto const Bt = dN * Jacobian.inverse();
+    thread_local matrix k_e;
+    thread_local vector f_int;
+
+    kernel->tangent_stiffness_and_internal_force(k_e,
+                                                 f_int,
+                                                 x,
+                                                 tangent_operators.offset(l),
+                                                 &cauchy_stresses[l],
+                                                 upper_only);
+    if (hourglass)
+    {
+        matrix2x const& X = local_initial_configuration(element);
 
-                               return Bt * cauchy_stress * Jacobian.determinant();
-                           });
-    return f_int;
+        hourglass->add_stiffness(k_e, X, tangent_operators[l], upper_only);
+        hourglass->add_internal_force(f_int, X, x, tangent_operators[l]);
+    }
+    return {k_e, f_int};
 }
 
-matrix const& submesh::geometric_tangent_stiffness(matrix2x const& x, std::int32_t const element) const
+auto submesh::tangent_stiffness_product(std::int32_t const element, vector const& u) const
+    -> vector const&
 {
+    matrix2x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
     auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-    thread_local matrix k_geo(nodes_per_element(), nodes_per_element());
-    thread_local matrix k_geo_full;
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-    sf->quadrature().integrate_inplace(k_geo, [&](auto const& N_dN, auto const l) {
-        auto const& [N, rhea] = N_dN;
+    thread_local vector product;
 
-        matrix2 const Jacobian = local_deformation_gradient(rhea, x);
+    kernel->tangent_stiffness_product(product,
+                                      u,
+                                      x,
+                                      tangent_operators.offset(l),
+                                      &cauchy_stresses[l]);
 
-        auto const cauchy = cauchy_stresses[view(element, l)];
+    if (hourglass)
+    {
+        hourglass->add_stiffness_product(product,
+                                         u,
+                                         local_initial_configuration(element),
+                                         tangent_operators[l]);
+    }
 
-        // Compute the symmetric gradient operator
-        auto const L = local_gradient(rhea, Jacobian);
+    return product;
+}
 
-        return L.transpose() * cauchy * L * Jacobian.determinant();
-    });
-    k_geo_full = identity_expansion(k_geo, dofs_per_node());
+auto submesh::tangent_stiffness_diagonal(std::int32_t const element) const -> vector const&
+{
+    matrix2x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+
+    // First quadrature point of the element
+    auto const l = view(element, 0);
+
+    thread_local vector diagonal;
 
-    return k_geo_full;
+    kernel->tangent_stiffness_diagonal(diagonal,
+                                       x,
+                                       tangent_operators.offset(l),
+                                       &cauchy_stresses[l]);
+
+    if (hourglass)
+    {
+        hourglass->add_stiffness_diagonal(diagonal,
+                                          local_initial_configuration(element),
+                                          tangent_operators[l]);
+    }
+
+    return diagonal;
 }
 
-matrix const& submesh::material_tangent_stiffness(matrix2x const& x, std::int32_t const element) const
+auto submesh::internal_force(std::int32_t const element) const -> vector const&
 {
-    auto const local_dofs = nodes_per_element() * dofs_per_node();
+    matrix2x const& x = local_current_configuration(element);
+
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+
+    // First quadrature point of the element
+    auto const l = view(element, 0);
+
+    thread_local vector f_int;
 
-    thread_local matrix k_mat(local_dofs, local_dofs);
+    kernel->internal_force(f_int, x, &cauchy_stresses[l]);
 
-    k_mat.setZero();
+    if (hourglass)
+    {
+        auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
-    auto const& tangent_operators = variables->get(variable::fourth::tangent_operator);
+        hourglass->add_internal_force(f_int,
+                                      local_initial_configuration(element),
+                                      x,
+                                      tangent_operators[l]);
+    }
+    return f_int;
+}
 
-    matrix B = matrix::Zero(4, local_dofs);
+auto submesh::local_initial_configuration(std::int32_t const element) const -> matrix2x const&
+{
+    thread_local matrix3x X_3;
+    thread_local matrix2x X;
 
-    sf->quadrature().integrate_inplace(k_mat, [&](auto const& femval, auto const& l) {
-        auto const& [N, rhea] = femval;
+    X_3 = coordinates->initial_configuration(local_node_view(element));
 
-        auto const& D = tangent_operators[view(element, l)];
+    geometry::project_to_plane(X, X_3);
 
-        matrix2 const Jacobian{local_deformation_gradient(rhea, x)};
+    return X;
+}
 
-        symmetric_gradient<2>(B, (rhea * Jacobian.inverse()).transpose());
+auto submesh::local_current_configuration(std::int32_t const element) const -> matrix2x const&
+{
+    thread_local matrix3x x_3;
+    thread_local matrix2x x;
 
-        return B.transpose() * D * B * Jacobian.determinant();
-    });
-    return k_mat;
+    x_3 = coordinates->current_configuration(local_node_view(element));
+
+    geometry::project_to_plane(x, x_3);
+
+    return x;
 }
 
 auto submesh::consistent_mass(std::int32_t const element) const -> matrix const&
 {
-    static matrix X;
+    thread_local matrix X;
 
     X = coordinates->initial_configuration(local_node_view(element));
 
@@ -187,6 +304,8 @@ void submesh::update_internal_variables(double const time_step_size)
 {
     std::feclearexcept(FE_ALL_EXCEPT);
 
+    variables->advance();
+
     update_deformation_measures();
 
     update_Jacobian_determinants();
@@ -199,6 +318,24 @@ void submesh::update_internal_variables(double const time_step_size)
     }
 }
 
+void submesh::update_stress(double const time_step_size)
+{
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    variables->advance();
+
+    update_deformation_measures();
+
+    update_Jacobian_determinants();
+
+    cm->update_stress(time_step_size);
+
+    if (std::fetestexcept(FE_INVALID))
+    {
+        throw computational_error("Floating point error reported\n");
+    }
+}
+
 void submesh::update_deformation_measures()
 {
     auto& H_list = variables->get(variable::second::displacement_gradient);
@@ -207,10 +344,8 @@ void submesh::update_deformation_measures()
     for (std::int64_t element{0}; element < elements(); ++element)
     {
         // Gather the material coordinates
-        auto const X = geometry::project_to_plane(
-            coordinates->initial_configuration(local_node_view(element)));
-        auto const x = geometry::project_to_plane(
-            coordinates->current_configuration(local_node_view(element)));
+        matrix2x const& X = local_initial_configuration(element);
+        matrix2x const& x = local_current_configuration(element);
 
         sf->quadrature().for_each([&](auto const& femval, const auto& l) {
             auto const& [N, rhea] = femval;
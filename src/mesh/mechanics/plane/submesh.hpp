@@ -8,6 +8,8 @@
 #include "constitutive/constitutive_model.hpp"
 #include "constitutive/internal_variables.hpp"
 #include "interpolations/shape_function.hpp"
+#include "mesh/mechanics/element_kernel.hpp"
+#include "mesh/mechanics/hourglass_control.hpp"
 #include "math/view.hpp"
 #include "traits/mechanics.hpp"
 
@@ -46,6 +48,12 @@ public:
 
     void save_internal_variables(bool const have_converged);
 
+    /// Store the history of the internal variables before a trial update
+    void checkpoint_internal_variables();
+
+    /// Undo any trial updates since the last checkpoint
+    void restore_internal_variables();
+
     [[nodiscard]] auto dofs_per_node() const noexcept { return traits::dofs_per_node; }
 
     [[nodiscard]] auto const& shape_function() const { return *sf; }
@@ -55,6 +63,22 @@ public:
     /// \return the tangent consistent stiffness matrix
     [[nodiscard]] auto tangent_stiffness(std::int32_t const element) const -> matrix const&;
 
+    /// \return upper triangle of the tangent consistent stiffness matrix,
+    /// where the lower triangle is not computed.  This requires a symmetric
+    /// constitutive model.
+    [[nodiscard]] auto symmetric_tangent_stiffness(std::int32_t const element) const
+        -> matrix const&;
+
+    /// \return the product of the tangent consistent stiffness matrix with the
+    /// element vector \p u evaluated at the quadrature points without forming
+    /// the element matrix
+    [[nodiscard]] auto tangent_stiffness_product(std::int32_t const element, vector const& u) const
+        -> vector const&;
+
+    /// \return the diagonal of the tangent consistent stiffness matrix
+    [[nodiscard]] auto tangent_stiffness_diagonal(std::int32_t const element) const
+        -> vector const&;
+
     /**
      * Compute the internal force vector using the formula
      * \f{align*}{
@@ -64,6 +88,70 @@ public:
      */
     [[nodiscard]] auto internal_force(std::int32_t const element) const -> vector const&;
 
+    /**
+     * Compute the tangent consistent stiffness matrix and the internal force
+     * vector together in a single pass over the quadrature points, such that
+     * the geometric quantities are evaluated only once.  Only the upper
+     * triangle of the stiffness matrix is computed when \p upper_only is set.
+     * \return element stiffness matrix and internal force
+     */
+    [[nodiscard]] auto tangent_stiffness_and_internal_force(std::int32_t const element,
+                                                            bool const upper_only) const
+        -> std::pair<matrix const&, vector const&>;
+
+    /// \return number of elements evaluated together by the batched routines.
+    /// Plane elements are projected into the plane of each element and are
+    /// evaluated one at a time.
+    [[nodiscard]] auto batch_size() const noexcept -> std::int64_t { return 1; }
+
+    /// Compute the internal force for the \p count elements in \p elements
+    /// and call \p function with each element and its internal force
+    template <typename Callable>
+    void internal_force(std::int64_t const* elements,
+                        std::int64_t const count,
+                        Callable&& function) const
+    {
+        for (std::int64_t index{0}; index < count; ++index)
+        {
+            function(elements[index], internal_force(elements[index]));
+        }
+    }
+
+    /// Compute the tangent stiffness matrix for the \p count elements in
+    /// \p elements and call \p function with each element and its stiffness
+    /// matrix, where only the upper triangle is computed when \p upper_only
+    /// is set
+    template <typename Callable>
+    void tangent_stiffness(std::int64_t const* elements,
+                           std::int64_t const count,
+                           bool const upper_only,
+                           Callable&& function) const
+    {
+        for (std::int64_t index{0}; index < count; ++index)
+        {
+            function(elements[index],
+                     upper_only ? symmetric_tangent_stiffness(elements[index])
+                                : tangent_stiffness(elements[index]));
+        }
+    }
+
+    /// Compute the tangent stiffness matrix and the internal force for the
+    /// \p count elements in \p elements and call \p function with each
+    /// element, its stiffness matrix and its internal force
+    template <typename Callable>
+    void tangent_stiffness_and_internal_force(std::int64_t const* elements,
+                                              std::int64_t const count,
+                                              bool const upper_only,
+                                              Callable&& function) const
+    {
+        for (std::int64_t index{0}; index < count; ++index)
+        {
+            auto const [k_e, f_int] = tangent_stiffness_and_internal_force(elements[index],
+                                                                           upper_only);
+            function(elements[index], k_e, f_int);
+        }
+    }
+
     /// \return the consistent mass matrix \sa diagonal_mass
     [[nodiscard]] auto consistent_mass(std::int32_t const element) const -> matrix const&;
 
@@ -76,6 +164,11 @@ public:
     /// \sa check_element_distortion()
     void update_internal_variables(double const time_step_size = 1.0);
 
+    /// Update the internal variables required for the stress without the
+    /// tangent operator for an evaluation of the internal force only
+    /// \sa update_internal_variables
+    void update_stress(double const time_step_size = 1.0);
+
     [[nodiscard]] auto nodal_averaged_variable(variable::scalar const scalar_name) const
         -> std::pair<vector, vector>;
 
@@ -89,27 +182,15 @@ protected:
     /// Computes the Jacobian determinants and check if negative
     void update_Jacobian_determinants();
 
-    /**
-     * Compute the geometric stiffness matrix for in the computation solid
-     * mechanics element. The expression to be evaluated through numerical
-     * integration is the following:
-       \f{align*}{
-        k_{geo} &= \sum_l^{L} B(\xi_l, \eta_l, \zeta_l)^T \sigma(l) B(\xi_l,
-     \eta_l, \zeta_l) w(l)
-       \f}
-     * Where B is the gradient operator in the finite element discretization
-     */
-    [[nodiscard]] matrix const& geometric_tangent_stiffness(matrix2x const& configuration,
-                                                            std::int32_t const element) const;
+    /// \return the initial nodal coordinates of \p element projected to the
+    /// plane in thread local storage, which avoids an allocation for each element
+    [[nodiscard]] auto local_initial_configuration(std::int32_t const element) const
+        -> matrix2x const&;
 
-    /**
-     * Compute the material tangent stiffness using the formula
-     * \f{align*}{
-     * k_{mat} &= I_{2x2} \int_{V} B_I^{T} \sigma B_{J} dV
-     * \f}
-     */
-    [[nodiscard]] matrix const& material_tangent_stiffness(matrix2x const& configuration,
-                                                           std::int32_t const element) const;
+    /// \return the current nodal coordinates of \p element in the plane
+    /// \sa local_initial_configuration
+    [[nodiscard]] auto local_current_configuration(std::int32_t const element) const
+        -> matrix2x const&;
 
 private:
     /// Nodal coordinates
@@ -121,6 +202,10 @@ private:
     std::shared_ptr<internal_variables_t> variables;
     /// Constitutive model
     std::unique_ptr<constitutive_model> cm;
+    /// Element routines for the element topology
+    std::unique_ptr<element_kernel<2>> kernel;
+    /// Hourglass stabilisation for one point quadrature of linear quadrilaterals
+    std::unique_ptr<hourglass_control<2>> hourglass;
     /// Map for the local element to process indices
     indices dof_list;
 };
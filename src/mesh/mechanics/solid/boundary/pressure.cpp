@@ -7,34 +7,50 @@
 
 namespace neon::mechanics::solid
 {
+pressure::pressure(std::unique_ptr<surface_interpolation>&& sf,
+                   indices node_indices,
+                   indices dof_indices,
+                   std::shared_ptr<material_coordinates>& coordinates,
+                   json const& time_history,
+                   json const& load_history)
+    : traction(std::move(sf), node_indices, dof_indices, coordinates, time_history, load_history)
+{
+    integrate_reference_normals();
+}
+
 std::pair<index_view, vector> pressure::external_force(std::int64_t const element,
                                                        double const load_factor) const
 {
-    auto const node_view = node_indices(Eigen::all, element);
+    return {dof_indices(Eigen::all, element),
+            -interpolate_prescribed_load(load_factor) * reference_normals.col(element)};
+}
 
-    matrix3x const& X = coordinates->initial_configuration(node_view);
+void pressure::integrate_reference_normals()
+{
+    reference_normals.resize(dof_indices.rows(), elements());
 
-    auto const pressure = interpolate_prescribed_load(load_factor);
+    for (std::int64_t element{0}; element < elements(); ++element)
+    {
+        matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
 
-    // Perform the computation of the external load vector
-    matrix f_ext = -pressure
-                   * sf->quadrature().integrate(matrix::Zero(X.cols(), 3).eval(),
-                                                [&](auto const& femval, auto) -> matrix {
-                                                    auto const& [N, dN] = femval;
+        matrix const f_ext = sf->quadrature().integrate(
+            matrix::Zero(X.cols(), 3).eval(), [&](auto const& femval, auto) -> matrix {
+                auto const& [N, dN] = femval;
 
-                                                    matrix32 const jacobian = X * dN;
+                matrix32 const jacobian = X * dN;
 
-                                                    auto const j = jacobian_determinant(jacobian);
+                auto const j = jacobian_determinant(jacobian);
 
-                                                    vector3 dx_dxi = jacobian.col(0);
-                                                    vector3 dx_deta = jacobian.col(1);
+                vector3 dx_dxi = jacobian.col(0);
+                vector3 dx_deta = jacobian.col(1);
 
-                                                    vector3 normal = dx_dxi.cross(dx_deta).normalized();
+                vector3 normal = dx_dxi.cross(dx_deta).normalized();
 
-                                                    return N * normal.transpose() * j;
-                                                });
+                return N * normal.transpose() * j;
+            });
 
-    // Map the matrix back to a vector for the assembly operator
-    return {dof_indices(Eigen::all, element), Eigen::Map<matrix>(f_ext.data(), X.cols() * 3, 1)};
+        // Map the matrix back to a vector for the assembly operator
+        reference_normals.col(element) = Eigen::Map<vector const>(f_ext.data(), X.cols() * 3);
+    }
 }
 }
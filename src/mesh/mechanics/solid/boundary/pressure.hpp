@@ -18,11 +18,25 @@ namespace neon::mechanics::solid
 class pressure : public traction
 {
 public:
-    using traction::traction;
+    explicit pressure(std::unique_ptr<surface_interpolation>&& sf,
+                      indices node_indices,
+                      indices dof_indices,
+                      std::shared_ptr<material_coordinates>& coordinates,
+                      json const& time_history,
+                      json const& load_history);
 
     /// Evaluated the external force contributions for a pressure boundary
     /// condition in the initial configuration.
     std::pair<index_view, vector> external_force(std::int64_t const element,
                                                  double const load_factor) const override;
+
+protected:
+    /// Integrate the outward normal weighted by the shape functions over each
+    /// element in the initial configuration
+    void integrate_reference_normals();
+
+protected:
+    /// Element load vector for a unit pressure in each column
+    col_matrix reference_normals;
 };
 }
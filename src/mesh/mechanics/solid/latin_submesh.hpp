@@ -31,8 +31,16 @@ namespace mechanics::solid
 class latin_submesh : public mechanics::solid::submesh
 {
 public:
-    // use the base class constructor
-    using mechanics::solid::submesh::submesh;
+    explicit latin_submesh(json const& material_data,
+                           json const& mesh_data,
+                           std::shared_ptr<material_coordinates>& coordinates,
+                           basic_submesh const& submesh)
+        : mechanics::solid::submesh(material_data, mesh_data, coordinates, submesh)
+    {
+        // The search direction uses the converged stress and strain
+        variables->mark_history(variable::second::cauchy_stress,
+                                variable::second::displacement_gradient);
+    }
 
     /**
      * Compute the incremental latin internal force vector, infinite/vertical search direction,
@@ -51,13 +59,13 @@ inline std::pair<index_view, vector const&> latin_submesh::incremental_latin_int
     std::int32_t const element,
     double const latin_search_direction) const
 {
-    matrix3x const& x = coordinates->current_configuration(local_node_view(element));
+    matrix3x const& x = local_current_configuration(element);
 
     auto const& cauchy_stresses_local = variables->get(variable::second::cauchy_stress);
 
     auto const& cauchy_stresses_old_local = variables->get_old(variable::second::cauchy_stress);
 
-    auto const& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
     // Compute the linear strain gradient from the displacement gradient
     auto strains_old_global = variables->get(variable::second::displacement_gradient)
@@ -67,44 +75,43 @@ inline std::pair<index_view, vector const&> latin_submesh::incremental_latin_int
                              | ranges::view::transform(
                                    [](auto const& H) { return 0.5 * (H + H.transpose()); });
 
-    static vector f_int_latin(nodes_per_element() * dofs_per_node());
-    f_int_latin.setZero();
+    thread_local vector f_int_latin(nodes_per_element() * dofs_per_node());
+    f_int_latin.setZero(nodes_per_element() * dofs_per_node());
 
     sf->quadrature()
-        .integrate_inplace(Eigen::Map<row_matrix>(f_int_latin.data(),
-                                                  nodes_per_element(),
-                                                  dofs_per_node()),
-                           [&](auto const& N_dN, auto const index) -> matrix {
-                               auto const& [N, dN] = N_dN;
-
-                               matrix3 const jacobian = local_deformation_gradient(dN, x);
-
-                               matrix3 const&
-                                   cauchy_stress_local = cauchy_stresses_local[view(element, index)];
-
-                               matrix3 const&
-                                   cauchy_stress_old_local = cauchy_stresses_old_local[view(element,
-                                                                                            index)];
-
-                               matrix3 const& strain_old_global = strains_old_global[view(element, index)];
-                               matrix3 const& strain_old_local = strains_old_local[view(element, index)];
-
-                               matrix3 const&
-                                   cauchy_stress_global = cauchy_stress_old_local
-                                                          + latin_search_direction
-                                                                * voigt::kinetic::from(
-                                                                      tangent_operators[view(element, index)]
-                                                                      * voigt::kinematic::to(
-                                                                            strain_old_global
-                                                                            - strain_old_local));
-
-                               // symmetric gradient operator
-                               matrix const Bt = dN * jacobian.inverse();
-
-                               // return minus_residual = latin_residual following the LATIN implicit scheme
-                               return Bt * (cauchy_stress_global - cauchy_stress_local)
-                                      * jacobian.determinant();
-                           });
+        .accumulate(Eigen::Map<row_matrix>(f_int_latin.data(),
+                                           nodes_per_element(),
+                                           dofs_per_node()),
+                    [&](auto& f, auto const& N_dN, auto const index, auto const w) {
+                        auto const& [N, dN] = N_dN;
+
+                        matrix3 const jacobian = local_deformation_gradient(dN, x);
+
+                        matrix3 const&
+                            cauchy_stress_local = cauchy_stresses_local[view(element, index)];
+
+                        matrix3 const&
+                            cauchy_stress_old_local = cauchy_stresses_old_local[view(element,
+                                                                                     index)];
+
+                        matrix3 const& strain_old_global = strains_old_global[view(element, index)];
+                        matrix3 const& strain_old_local = strains_old_local[view(element, index)];
+
+                        matrix3 const&
+                            cauchy_stress_global = cauchy_stress_old_local
+                                                   + latin_search_direction
+                                                         * voigt::kinetic::from(
+                                                               tangent_operators[view(element, index)]
+                                                               * voigt::kinematic::to(
+                                                                     strain_old_global
+                                                                     - strain_old_local));
+
+                        // return minus_residual = latin_residual following the LATIN implicit
+                        // scheme with the symmetric gradient operator applied last
+                        f.noalias() += (jacobian.determinant() * w) * dN
+                                       * (jacobian.inverse()
+                                          * (cauchy_stress_global - cauchy_stress_local));
+                    });
 
     return {local_dof_view(element), f_int_latin};
 }
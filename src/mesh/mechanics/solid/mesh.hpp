@@ -51,10 +51,23 @@ public:
     /// time step increment
     void update_internal_variables(vector const& u, double const time_step_size = 0.0);
 
+    /// Deform the body by updating the displacement x = X + u and update
+    /// only the stress for an evaluation of the internal force
+    /// \sa update_internal_variables
+    void update_stress(vector const& u, double const time_step_size = 0.0);
+
     /// Update the internal variables if converged, otherwise revert values back
     /// for next attempted load increment
     void save_internal_variables(bool const have_converged);
 
+    /// Store the history of the internal variables before a trial update
+    void checkpoint_internal_variables();
+
+    /// Undo the trial updates of the internal variables since the last
+    /// checkpoint, such that an update at a new displacement accumulates the
+    /// history from the checkpoint
+    void restore_internal_variables();
+
     /// Constant access to the sub-meshes
     [[nodiscard]] std::vector<SubMeshType> const& meshes() const noexcept { return submeshes; }
 
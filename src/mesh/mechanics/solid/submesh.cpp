@@ -7,9 +7,9 @@
 
 #include "constitutive/constitutive_model_factory.hpp"
 #include "interpolations/interpolation_factory.hpp"
+#include "io/json.hpp"
 #include "material/material_property.hpp"
 #include "mesh/material_coordinates.hpp"
-#include "numeric/gradient_operator.hpp"
 #include "numeric/mechanics"
 #include "mesh/dof_allocator.hpp"
 #include "traits/mechanics.hpp"
@@ -18,8 +18,10 @@
 
 #include <tbb/parallel_for.h>
 
+#include <algorithm>
 #include <cfenv>
 #include <chrono>
+#include <numeric>
 
 namespace neon::mechanics::solid
 {
@@ -32,7 +34,11 @@ submesh::submesh(json const& material_data,
       sf(make_volume_interpolation(topology(), mesh_data)),
       view(sf->quadrature().points()),
       variables(std::make_shared<internal_variables_t>(elements() * sf->quadrature().points())),
-      cm(make_constitutive_model(variables, material_data, mesh_data))
+      cm(make_constitutive_model(variables, material_data, mesh_data)),
+      kernel(make_volume_element_kernel(topology(),
+                                        sf->quadrature(),
+                                        cm->is_finite_deformation())),
+      hourglass(make_hourglass_control(topology(), sf->quadrature(), mesh_data))
 {
     // Allocate storage for the displacement gradient
     variables->add(variable::second::displacement_gradient,
@@ -46,9 +52,71 @@ submesh::submesh(json const& material_data,
 
     std::fill(begin(deformation_gradients), end(deformation_gradients), matrix3::Identity());
 
+    // The kinematics and the stress are computed at every update and do not
+    // start from the converged values
+    variables->mark_recomputed(variable::second::displacement_gradient,
+                               variable::second::deformation_gradient,
+                               variable::second::cauchy_stress);
+    variables->mark_recomputed(variable::scalar::DetF);
+
     variables->commit();
 
     dof_allocator(node_indices, dof_indices, traits::dofs_per_node);
+
+    auto const& element_options = mesh_data["element_options"];
+
+    if (element_options.find("batched") != end(element_options)
+        && element_options["batched"].get<bool>())
+    {
+        batch_kernel = make_element_batch_kernel(topology(),
+                                                 sf->quadrature(),
+                                                 cm->is_finite_deformation());
+    }
+
+    // Symmetric tangent operators are stored as the upper triangle only
+    if (element_options.find("packed_tangent") != end(element_options)
+        && element_options["packed_tangent"].get<bool>() && cm->is_symmetric())
+    {
+        variables->pack(variable::fourth::tangent_operator);
+    }
+
+    // Elastic quadrature points refer to the tangent operator of the model
+    if (auto const* const shared_tangent = cm->shared_tangent();
+        shared_tangent
+        && (element_options.find("shared_tangent") == end(element_options)
+            || element_options["shared_tangent"].get<bool>()))
+    {
+        variables->share(variable::fourth::tangent_operator, *shared_tangent);
+    }
+
+    if (element_options.find("cache_reference_geometry") == end(element_options)
+        || element_options["cache_reference_geometry"].get<bool>())
+    {
+        cache_reference_geometry();
+    }
+}
+
+void submesh::checkpoint_internal_variables() { variables->checkpoint(); }
+
+void submesh::restore_internal_variables() { variables->restore(); }
+
+void submesh::cache_reference_geometry()
+{
+    reference_jacobian_inverses.resize(elements() * sf->quadrature().points());
+    reference_jacobian_determinants.resize(elements() * sf->quadrature().points());
+
+    tbb::parallel_for(std::int64_t{0}, elements(), [&](auto const element) {
+        matrix3x const& X = local_initial_configuration(element);
+
+        sf->quadrature().for_each([&](auto const& femval, auto const l) {
+            auto const& [N, dN] = femval;
+
+            matrix3 const F_0 = local_deformation_gradient(dN, X);
+
+            reference_jacobian_inverses[view(element, l)] = F_0.inverse();
+            reference_jacobian_determinants[view(element, l)] = F_0.determinant();
+        });
+    });
 }
 
 void submesh::save_internal_variables(bool const have_converged)
@@ -65,119 +133,320 @@ void submesh::save_internal_variables(bool const have_converged)
 
 auto submesh::tangent_stiffness(std::int32_t const element) const -> matrix const&
 {
-    matrix3x const& x = coordinates->current_configuration(local_node_view(element));
+    matrix3x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-    thread_local matrix k_e(nodes_per_element() * dofs_per_node(),
-                            nodes_per_element() * dofs_per_node());
+    thread_local matrix k_e;
 
-    k_e = material_tangent_stiffness(x, element);
+    kernel->tangent_stiffness(k_e, x, tangent_operators.offset(l), &cauchy_stresses[l], false);
 
-    if (cm->is_finite_deformation())
+    if (hourglass)
     {
-        k_e.noalias() += geometric_tangent_stiffness(x, element);
+        hourglass->add_stiffness(k_e,
+                                 local_initial_configuration(element),
+                                 tangent_operators[l],
+                                 false);
     }
     return k_e;
 }
 
-auto submesh::internal_force(std::int32_t const element) const -> vector const&
+auto submesh::symmetric_tangent_stiffness(std::int32_t const element) const -> matrix const&
 {
-    matrix3x const& x = coordinates->current_configuration(local_node_view(element));
+    matrix3x const& x = local_current_configuration(element);
 
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
     auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-    static vector f_int(nodes_per_element() * dofs_per_node());
+    // First quadrature point of the element
+    auto const l = view(element, 0);
+
+    thread_local matrix k_e;
 
-    f_int.setZero();
+    kernel->tangent_stiffness(k_e, x, tangent_operators.offset(l), &cauchy_stresses[l], true);
+
+    if (hourglass)
+    {
+        hourglass->add_stiffness(k_e,
+                                 local_initial_configuration(element),
+                                 tangent_operators[l],
+                                 true);
+    }
+    return k_e;
+}
 
-    sf->quadrature()
-        .integrate_inplace(Eigen::Map<row_matrix>(f_int.data(), nodes_per_element(), dofs_per_node()),
-                           [&](auto const& N_dN, auto const index) -> matrix {
-                               auto const& [N, dN] = N_dN;
+auto submesh::tangent_stiffness_and_internal_force(std::int32_t const element,
+                                                   bool const upper_only) const
+    -> std::pair<matrix const&, vector const&>
+{
+    matrix3x const& x = local_current_configuration(element);
 
-                               matrix3 const jacobian = local_deformation_gradient(dN, x);
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-                               matrix3 const& cauchy_stress = cauchy_stresses[view(element, index)];
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-                               // symmetric gradient operator
-                               matrix const Bt = dN * jacobian.inverse();
+    thread_local matrix k_e;
+    thread_local vector f_int;
 
-                               return Bt * cauchy_stress * jacobian.determinant();
-                           });
+    kernel->tangent_stiffness_and_internal_force(k_e,
+                                                 f_int,
+                                                 x,
+                                                 tangent_operators.offset(l),
+                                                 &cauchy_stresses[l],
+                                                 upper_only);
+    if (hourglass)
+    {
+        matrix3x const& X = local_initial_configuration(element);
 
-    return f_int;
+        hourglass->add_stiffness(k_e, X, tangent_operators[l], upper_only);
+        hourglass->add_internal_force(f_int, X, x, tangent_operators[l]);
+    }
+    return {k_e, f_int};
 }
 
-matrix const& submesh::geometric_tangent_stiffness(matrix3x const& x, std::int32_t const element) const
+auto submesh::tangent_stiffness_product(std::int32_t const element, vector const& u) const
+    -> vector const&
 {
+    matrix3x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
     auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-    thread_local matrix k_geo(nodes_per_element(), nodes_per_element());
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-    thread_local matrix k_geo_full(nodes_per_element() * dofs_per_node(),
-                                   nodes_per_element() * dofs_per_node());
+    thread_local vector product;
 
-    sf->quadrature().integrate_inplace(k_geo.setZero(), [&](auto const& N_dN, auto const index) -> matrix {
-        auto const& [N, dN] = N_dN;
+    kernel->tangent_stiffness_product(product,
+                                      u,
+                                      x,
+                                      tangent_operators.offset(l),
+                                      &cauchy_stresses[l]);
 
-        matrix3 const J = local_deformation_gradient(dN, x);
+    if (hourglass)
+    {
+        hourglass->add_stiffness_product(product,
+                                         u,
+                                         local_initial_configuration(element),
+                                         tangent_operators[l]);
+    }
+
+    return product;
+}
 
-        matrix3 const& cauchy_stress = cauchy_stresses[view(element, index)];
+auto submesh::tangent_stiffness_diagonal(std::int32_t const element) const -> vector const&
+{
+    matrix3x const& x = local_current_configuration(element);
+
+    auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-        matrix const L = local_gradient(dN, J);
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-        return L.transpose() * cauchy_stress * L * J.determinant();
-    });
+    thread_local vector diagonal;
 
-    identity_expansion_inplace<3>(k_geo, k_geo_full.setZero());
+    kernel->tangent_stiffness_diagonal(diagonal,
+                                       x,
+                                       tangent_operators.offset(l),
+                                       &cauchy_stresses[l]);
 
-    return k_geo_full;
+    if (hourglass)
+    {
+        hourglass->add_stiffness_diagonal(diagonal,
+                                          local_initial_configuration(element),
+                                          tangent_operators[l]);
+    }
+
+    return diagonal;
 }
 
-matrix const& submesh::material_tangent_stiffness(matrix3x const& x, std::int32_t const element) const
+auto submesh::internal_force(std::int32_t const element) const -> vector const&
 {
-    auto const& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    matrix3x const& x = local_current_configuration(element);
 
-    auto const local_dofs = nodes_per_element() * dofs_per_node();
+    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
 
-    thread_local matrix k_mat(local_dofs, local_dofs);
-    thread_local matrix B(6, local_dofs);
+    // First quadrature point of the element
+    auto const l = view(element, 0);
 
-    k_mat.setZero();
-    B.setZero();
+    thread_local vector f_int;
 
-    sf->quadrature().integrate_inplace(k_mat, [&](auto const& N_dN, auto const l) -> matrix {
-        auto const& [N, dN] = N_dN;
+    kernel->internal_force(f_int, x, &cauchy_stresses[l]);
 
-        matrix6 const& D = tangent_operators[view(element, l)];
+    if (hourglass)
+    {
+        auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
 
-        matrix3 const jacobian = local_deformation_gradient(dN, x);
+        hourglass->add_internal_force(f_int,
+                                      local_initial_configuration(element),
+                                      x,
+                                      tangent_operators[l]);
+    }
+    return f_int;
+}
 
-        symmetric_gradient<3>(B, local_gradient(dN, jacobian));
+auto submesh::local_initial_configuration(std::int64_t const element) const -> matrix3x const&
+{
+    thread_local matrix3x X;
 
-        return B.transpose() * D * B * jacobian.determinant();
-    });
-    return k_mat;
+    X = coordinates->initial_configuration(local_node_view(element));
+
+    return X;
+}
+
+auto submesh::local_current_configuration(std::int64_t const element) const -> matrix3x const&
+{
+    thread_local matrix3x x;
+
+    x = coordinates->current_configuration(local_node_view(element));
+
+    return x;
+}
+
+auto submesh::make_batch(std::int64_t const* elements, std::int64_t const count) const
+    -> element_batch_kernel::batch
+{
+    element_batch_kernel::batch batch;
+
+    batch.size = count;
+
+    for (std::int64_t lane{0}; lane < element_batch_kernel::lanes; ++lane)
+    {
+        // Unused lanes repeat the first element to avoid a degenerate geometry
+        auto const element = elements[lane < count ? lane : 0];
+
+        batch.nodes[lane] = &node_indices(0, element);
+        batch.offsets[lane] = view(element, 0);
+    }
+    return batch;
+}
+
+auto submesh::batched_internal_force(std::int64_t const* elements, std::int64_t const count) const
+    -> std::array<vector, element_batch_kernel::lanes> const&
+{
+    thread_local std::array<vector, element_batch_kernel::lanes> f_int;
+
+    batch_kernel->internal_force(f_int,
+                                 make_batch(elements, count),
+                                 coordinates->current_coordinates(),
+                                 variables->get(variable::second::cauchy_stress));
+
+    if (hourglass)
+    {
+        auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+
+        for (std::int64_t lane{0}; lane < count; ++lane)
+        {
+            hourglass->add_internal_force(f_int[lane],
+                                          local_initial_configuration(elements[lane]),
+                                          local_current_configuration(elements[lane]),
+                                          tangent_operators[view(elements[lane], 0)]);
+        }
+    }
+    return f_int;
+}
+
+auto submesh::batched_tangent_stiffness(std::int64_t const* elements,
+                                        std::int64_t const count,
+                                        bool const upper_only) const
+    -> std::array<matrix, element_batch_kernel::lanes> const&
+{
+    thread_local std::array<matrix, element_batch_kernel::lanes> k_e;
+
+    batch_kernel->tangent_stiffness(k_e,
+                                    make_batch(elements, count),
+                                    coordinates->current_coordinates(),
+                                    variables->voigt_view(variable::fourth::tangent_operator),
+                                    variables->get(variable::second::cauchy_stress),
+                                    upper_only);
+
+    if (hourglass)
+    {
+        auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+
+        for (std::int64_t lane{0}; lane < count; ++lane)
+        {
+            hourglass->add_stiffness(k_e[lane],
+                                     local_initial_configuration(elements[lane]),
+                                     tangent_operators[view(elements[lane], 0)],
+                                     upper_only);
+        }
+    }
+    return k_e;
+}
+
+auto submesh::batched_tangent_stiffness_and_internal_force(std::int64_t const* elements,
+                                                           std::int64_t const count,
+                                                           bool const upper_only) const
+    -> std::pair<std::array<matrix, element_batch_kernel::lanes> const&,
+                 std::array<vector, element_batch_kernel::lanes> const&>
+{
+    thread_local std::array<matrix, element_batch_kernel::lanes> k_e;
+    thread_local std::array<vector, element_batch_kernel::lanes> f_int;
+
+    batch_kernel->tangent_stiffness_and_internal_force(k_e,
+                                                       f_int,
+                                                       make_batch(elements, count),
+                                                       coordinates->current_coordinates(),
+                                                       variables->voigt_view(
+                                                           variable::fourth::tangent_operator),
+                                                       variables->get(
+                                                           variable::second::cauchy_stress),
+                                                       upper_only);
+
+    if (hourglass)
+    {
+        auto const tangent_operators = variables->voigt_view(variable::fourth::tangent_operator);
+
+        for (std::int64_t lane{0}; lane < count; ++lane)
+        {
+            matrix3x const& X = local_initial_configuration(elements[lane]);
+
+            auto const& D = tangent_operators[view(elements[lane], 0)];
+
+            hourglass->add_stiffness(k_e[lane], X, D, upper_only);
+            hourglass->add_internal_force(f_int[lane],
+                                          X,
+                                          local_current_configuration(elements[lane]),
+                                          D);
+        }
+    }
+    return {k_e, f_int};
 }
 
 auto submesh::consistent_mass(std::int32_t const element) const -> matrix const&
 {
-    matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
+    matrix3x const& X = local_initial_configuration(element);
 
     auto const density = cm->intrinsic_material().initial_density();
 
-    thread_local matrix local_mass(nodes_per_element(), nodes_per_element());
-    thread_local matrix mass(nodes_per_element() * dofs_per_node(),
-                             nodes_per_element() * dofs_per_node());
+    thread_local matrix local_mass;
+    thread_local matrix mass;
 
-    sf->quadrature().integrate_inplace(local_mass.setZero(), [&](auto const& femval, auto) -> matrix {
-        auto const& [N, dN] = femval;
+    auto const reference_determinant = [&](auto const& dN, auto const l) -> double {
+        return reference_jacobian_determinants.empty()
+                   ? local_deformation_gradient(dN, X).determinant()
+                   : reference_jacobian_determinants[view(element, l)];
+    };
 
-        matrix3 const J = local_deformation_gradient(dN, X);
+    sf->quadrature().accumulate(local_mass.setZero(nodes_per_element(), nodes_per_element()),
+                                [&](auto& m, auto const& femval, auto const l, auto const w) {
+                                    auto const& [N, dN] = femval;
 
-        return density * N * N.transpose() * J.determinant();
-    });
+                                    m.noalias() += (density * reference_determinant(dN, l) * w)
+                                                   * N * N.transpose();
+                                });
 
-    identity_expansion_inplace<3>(local_mass, mass.setZero());
+    identity_expansion_inplace<3>(local_mass,
+                                  mass.setZero(nodes_per_element() * dofs_per_node(),
+                                               nodes_per_element() * dofs_per_node()));
 
     return mass;
 }
@@ -195,6 +464,8 @@ void submesh::update_internal_variables(double const time_step_size)
 {
     std::feclearexcept(FE_ALL_EXCEPT);
 
+    variables->advance();
+
     update_deformation_measures();
 
     update_Jacobian_determinants();
@@ -207,31 +478,76 @@ void submesh::update_internal_variables(double const time_step_size)
     }
 }
 
+void submesh::update_stress(double const time_step_size)
+{
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    variables->advance();
+
+    update_deformation_measures();
+
+    update_Jacobian_determinants();
+
+    cm->update_stress(time_step_size);
+
+    if (std::fetestexcept(FE_INVALID))
+    {
+        throw computational_error("Floating point error reported\n");
+    }
+}
+
 void submesh::update_deformation_measures()
 {
     auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
     auto& deformation_gradients = variables->get(variable::second::deformation_gradient);
 
+    if (batch_kernel)
+    {
+        auto& F_determinants = variables->get(variable::scalar::DetF);
+
+        std::int64_t const lanes = element_batch_kernel::lanes;
+
+        tbb::parallel_for(std::int64_t{0}, (elements() + lanes - 1) / lanes, [&](auto const batch) {
+            std::array<std::int64_t, element_batch_kernel::lanes> batch_elements;
+
+            std::iota(begin(batch_elements), end(batch_elements), batch * lanes);
+
+            batch_kernel->deformation_measures(make_batch(batch_elements.data(),
+                                                          std::min(lanes,
+                                                                   elements() - batch * lanes)),
+                                               coordinates->coordinates(),
+                                               coordinates->current_coordinates(),
+                                               reference_jacobian_inverses,
+                                               displacement_gradients,
+                                               deformation_gradients,
+                                               F_determinants);
+        });
+        return;
+    }
+
     tbb::parallel_for(std::int64_t{0}, elements(), [&](auto const element) {
         // Gather the material coordinates
-        matrix3x const& X = coordinates->initial_configuration(local_node_view(element));
-        matrix3x const& x = coordinates->current_configuration(local_node_view(element));
+        matrix3x const& X = local_initial_configuration(element);
+        matrix3x const& x = local_current_configuration(element);
 
         sf->quadrature().for_each([&](auto const& femval, auto const l) {
             auto const& [N, rhea] = femval;
 
-            // Local deformation gradient for the initial configuration
+            // Local deformation gradients for the initial and current configurations
             matrix3 const F_0 = local_deformation_gradient(rhea, X);
-            matrix3 const F = local_deformation_gradient(rhea, x);
+            matrix3 const F_x = local_deformation_gradient(rhea, x);
+
+            matrix3 const F_0_inv = reference_jacobian_inverses.empty()
+                                        ? F_0.inverse().eval()
+                                        : reference_jacobian_inverses[view(element, l)];
 
-            // Gradient operator in index notation
-            matrixxd<3> const B_0t = rhea * F_0.inverse();
+            matrix3 const F = F_x * F_0_inv;
 
-            // Displacement gradient
-            matrix3 const H = (x - X) * B_0t;
+            // Displacement gradient from the local gradient of the displacement
+            matrix3 const H = (F_x - F_0) * F_0_inv;
 
             displacement_gradients[view(element, l)] = H;
-            deformation_gradients[view(element, l)] = F * F_0.inverse();
+            deformation_gradients[view(element, l)] = F;
         });
     });
 }
@@ -242,10 +558,14 @@ void submesh::update_Jacobian_determinants()
 
     auto& F_determinants = variables->get(variable::scalar::DetF);
 
-    std::transform(begin(deformation_gradients),
-                   end(deformation_gradients),
-                   begin(F_determinants),
-                   [](matrix3 const& F) { return F.determinant(); });
+    // The batched deformation measures include the determinants
+    if (!batch_kernel)
+    {
+        std::transform(begin(deformation_gradients),
+                       end(deformation_gradients),
+                       begin(F_determinants),
+                       [](matrix3 const& F) { return F.determinant(); });
+    }
 
     auto const found = std::find_if(begin(F_determinants), end(F_determinants), [](auto const i) {
         return std::signbit(i);
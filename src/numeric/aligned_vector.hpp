@@ -0,0 +1,69 @@
+
+#pragma once
+
+/// @file
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace neon
+{
+/// Alignment in bytes of the contiguous variable storage, which is the size
+/// of a cache line and of the widest vector registers
+inline constexpr std::size_t storage_alignment = 64;
+
+/// aligned_allocator allocates storage on a boundary of \p Alignment bytes
+/// using the aligned forms of operator new and operator delete
+template <typename T, std::size_t Alignment = storage_alignment>
+class aligned_allocator
+{
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must be at least that of the type");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+public:
+    aligned_allocator() noexcept = default;
+
+    template <typename U>
+    aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t const size)
+    {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* const pointer, std::size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t{Alignment});
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(aligned_allocator<T, Alignment> const&,
+                aligned_allocator<U, Alignment> const&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(aligned_allocator<T, Alignment> const&,
+                aligned_allocator<U, Alignment> const&) noexcept
+{
+    return false;
+}
+
+/// aligned_vector is a std::vector where the first element is aligned to
+/// storage_alignment bytes
+template <typename T>
+using aligned_vector = std::vector<T, aligned_allocator<T>>;
+}
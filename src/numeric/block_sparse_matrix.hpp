@@ -0,0 +1,251 @@
+#pragma once
+
+/// @file
+
+#include "numeric/dense_matrix.hpp"
+#include "numeric/sparse_matrix.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace neon
+{
+/// block_sparse_matrix is a square sparse matrix stored in block compressed
+/// row (BSR) format.  Each non-zero entry is a dense BlockSize x BlockSize
+/// block stored in row major order, such that only a single column index is
+/// stored for each block.  This matches the node-wise numbering of the degrees
+/// of freedom (\sa dof_allocator) where each node pair couples all components.
+///
+/// The block structure is assumed to be structurally symmetric, which holds
+/// for every pattern formed through the element connectivity.
+template <int BlockSize>
+class block_sparse_matrix
+{
+public:
+    static_assert(BlockSize > 0, "Block size must be positive");
+
+    /// Number of rows and columns in each block
+    static auto constexpr block_size = BlockSize;
+
+    using index_type = std::int32_t;
+
+    using block_type = Eigen::Matrix<double, BlockSize, BlockSize, Eigen::RowMajor>;
+    using block_vector = Eigen::Matrix<double, BlockSize, 1>;
+
+public:
+    block_sparse_matrix() = default;
+
+    /// Set the block structure from the compressed block row format.
+    /// The values are allocated and set to zero.
+    /// \param row_offsets Position of the first block in each block row
+    /// \param column_indices Sorted block column index for each block
+    void set_structure(std::vector<index_type>&& row_offsets,
+                       std::vector<index_type>&& column_indices)
+    {
+        m_offsets = std::move(row_offsets);
+        m_columns = std::move(column_indices);
+        m_values.assign(m_columns.size() * block_size * block_size, 0.0);
+    }
+
+    /// \return number of scalar rows
+    [[nodiscard]] auto rows() const noexcept -> std::int64_t { return block_rows() * block_size; }
+
+    /// \return number of scalar columns
+    [[nodiscard]] auto cols() const noexcept -> std::int64_t { return rows(); }
+
+    /// \return number of block rows
+    [[nodiscard]] auto block_rows() const noexcept -> std::int64_t
+    {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+    /// \return number of stored blocks
+    [[nodiscard]] auto blocks() const noexcept -> std::int64_t { return m_columns.size(); }
+
+    /// \return number of stored scalar coefficients
+    [[nodiscard]] auto nonZeros() const noexcept -> std::int64_t { return m_values.size(); }
+
+    /// \return Position of the first block in each block row
+    [[nodiscard]] auto row_offsets() const noexcept -> std::vector<index_type> const&
+    {
+        return m_offsets;
+    }
+
+    /// \return Block column index of each block
+    [[nodiscard]] auto column_indices() const noexcept -> std::vector<index_type> const&
+    {
+        return m_columns;
+    }
+
+    /// \return an array view of all the stored coefficients
+    [[nodiscard]] auto coeffs() noexcept
+    {
+        return Eigen::Map<Eigen::ArrayXd>(m_values.data(), m_values.size());
+    }
+
+    /// \return an array view of all the stored coefficients
+    [[nodiscard]] auto coeffs() const noexcept
+    {
+        return Eigen::Map<Eigen::ArrayXd const>(m_values.data(), m_values.size());
+    }
+
+    /// \return pointer to the coefficients of the first block
+    [[nodiscard]] auto valuePtr() noexcept -> double* { return m_values.data(); }
+
+    /// \return a view of the block at the storage position \p index
+    [[nodiscard]] auto block(std::int64_t const index) noexcept
+    {
+        return Eigen::Map<block_type>(m_values.data() + index * block_size * block_size);
+    }
+
+    /// \return a view of the block at the storage position \p index
+    [[nodiscard]] auto block(std::int64_t const index) const noexcept
+    {
+        return Eigen::Map<block_type const>(m_values.data() + index * block_size * block_size);
+    }
+
+    /// \return storage position of the block (\p block_row, \p block_col) or
+    /// minus one if the block is not stored
+    [[nodiscard]] auto find_block(std::int64_t const block_row, std::int64_t const block_col) const
+        -> std::int64_t
+    {
+        auto const first = begin(m_columns) + m_offsets[block_row];
+        auto const last = begin(m_columns) + m_offsets[block_row + 1];
+
+        auto const location = std::lower_bound(first, last, block_col);
+
+        return location != last && *location == block_col ? location - begin(m_columns) : -1;
+    }
+
+    /// \return the coefficient at (\p row, \p col) or zero if it is not stored
+    [[nodiscard]] auto coeff(std::int64_t const row, std::int64_t const col) const -> double
+    {
+        auto const index = find_block(row / block_size, col / block_size);
+
+        return index < 0 ? 0.0 : block(index)(row % block_size, col % block_size);
+    }
+
+    /// \return a reference to the stored coefficient at (\p row, \p col)
+    [[nodiscard]] auto coeffRef(std::int64_t const row, std::int64_t const col) -> double&
+    {
+        auto const index = find_block(row / block_size, col / block_size);
+
+        eigen_assert(index >= 0 && "coefficient is not in the sparsity pattern");
+
+        return m_values[index * block_size * block_size + (row % block_size) * block_size
+                        + col % block_size];
+    }
+
+    /// Set the row and the column of \p dof to zero including the diagonal
+    void zero_row_and_column(std::int64_t const dof)
+    {
+        auto const block_row = dof / block_size;
+        auto const component = dof % block_size;
+
+        for (auto index = m_offsets[block_row]; index < m_offsets[block_row + 1]; ++index)
+        {
+            block(index).row(component).setZero();
+
+            // The transposed block holds the column entries
+            block(find_block(m_columns[index], block_row)).col(component).setZero();
+        }
+    }
+
+    /// \return the diagonal coefficients
+    [[nodiscard]] auto diagonal() const -> vector
+    {
+        vector diagonal_entries = vector::Zero(rows());
+
+        for (std::int64_t block_row{0}; block_row < block_rows(); ++block_row)
+        {
+            auto const index = find_block(block_row, block_row);
+
+            if (index >= 0)
+            {
+                diagonal_entries.template segment<block_size>(block_row * block_size) = block(index)
+                                                                                       .diagonal();
+            }
+        }
+        return diagonal_entries;
+    }
+
+    /// Compute the matrix vector product \p y = A * \p x in parallel over the block rows
+    void multiply(vector const& x, vector& y) const
+    {
+        y.resize(rows());
+
+        tbb::parallel_for(tbb::blocked_range<std::int64_t>{0, block_rows()}, [&](auto const& range) {
+            for (auto block_row = range.begin(); block_row != range.end(); ++block_row)
+            {
+                block_vector sum = block_vector::Zero();
+
+                for (auto index = m_offsets[block_row]; index < m_offsets[block_row + 1]; ++index)
+                {
+                    sum.noalias() += block(index)
+                                     * x.template segment<block_size>(m_columns[index] * block_size);
+                }
+                y.template segment<block_size>(block_row * block_size) = sum;
+            }
+        });
+    }
+
+    /// \return the matrix vector product A * \p x
+    [[nodiscard]] auto operator*(vector const& x) const -> vector
+    {
+        vector y;
+        multiply(x, y);
+        return y;
+    }
+
+    /// \return a copy in the compressed sparse row format with the same non-zeros
+    [[nodiscard]] auto to_sparse() const -> sparse_matrix
+    {
+        sparse_matrix A(rows(), cols());
+
+        auto* const outer_index = A.outerIndexPtr();
+
+        for (std::int64_t row{0}; row < rows(); ++row)
+        {
+            auto const block_row = row / block_size;
+
+            outer_index[row + 1] = outer_index[row]
+                                   + (m_offsets[block_row + 1] - m_offsets[block_row]) * block_size;
+        }
+
+        A.resizeNonZeros(outer_index[rows()]);
+
+        auto* const inner_index = A.innerIndexPtr();
+        auto* const values = A.valuePtr();
+
+        for (std::int64_t row{0}; row < rows(); ++row)
+        {
+            auto const block_row = row / block_size;
+
+            auto position = outer_index[row];
+
+            for (auto index = m_offsets[block_row]; index < m_offsets[block_row + 1]; ++index)
+            {
+                for (std::int64_t q{0}; q < block_size; ++q)
+                {
+                    inner_index[position] = m_columns[index] * block_size + q;
+                    values[position] = block(index)(row % block_size, q);
+                    ++position;
+                }
+            }
+        }
+        return A;
+    }
+
+protected:
+    /// Position of the first block in each block row
+    std::vector<index_type> m_offsets;
+    /// Block column index for each block
+    std::vector<index_type> m_columns;
+    /// Coefficients with each block stored contiguously
+    std::vector<double> m_values;
+};
+}
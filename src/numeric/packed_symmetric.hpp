@@ -0,0 +1,158 @@
+
+#pragma once
+
+/// @file
+
+#include "numeric/dense_matrix.hpp"
+
+#include <cstdint>
+
+namespace neon
+{
+/// Number of independent components of a symmetric matrix of size \p Size
+template <int Size>
+inline constexpr int packed_size = Size * (Size + 1) / 2;
+
+/// packed_symmetric stores the upper triangle of a symmetric matrix of size
+/// \p Size row by row, which holds 21 of the 36 components of a major symmetric
+/// fourth order tensor in Voigt notation
+template <int Size>
+using packed_symmetric = Eigen::Matrix<double, packed_size<Size>, 1>;
+
+/// \return the upper triangle of \p a in the packed layout
+template <int Size>
+auto pack_symmetric(Eigen::Matrix<double, Size, Size> const& a) -> packed_symmetric<Size>
+{
+    packed_symmetric<Size> packed;
+
+    for (int i{0}, k{0}; i < Size; ++i)
+    {
+        for (int j{i}; j < Size; ++j, ++k)
+        {
+            packed(k) = a(i, j);
+        }
+    }
+    return packed;
+}
+
+/// \return the symmetric matrix from the \p packed upper triangle
+template <int Size>
+auto unpack_symmetric(packed_symmetric<Size> const& packed) -> Eigen::Matrix<double, Size, Size>
+{
+    Eigen::Matrix<double, Size, Size> a;
+
+    for (int i{0}, k{0}; i < Size; ++i)
+    {
+        a(i, i) = packed(k++);
+
+        for (int j{i + 1}; j < Size; ++j, ++k)
+        {
+            a(i, j) = a(j, i) = packed(k);
+        }
+    }
+    return a;
+}
+
+/// voigt_tensor_view refers to the fourth order tensors in Voigt notation at
+/// consecutive quadrature points, which are stored either as full matrices or
+/// as symmetric matrices in the packed layout.  Constitutive models write the
+/// tensors through the view such that the storage layout is chosen by the
+/// owner of the variables, and the element kernels read each tensor as a full
+/// matrix in registers.  Quadrature points can further be tagged to refer to a
+/// single tensor shared by the constitutive model, such as the elastic moduli,
+/// which is then returned in place of the stored value.
+template <int Size>
+class voigt_tensor_view
+{
+public:
+    using value_type = Eigen::Matrix<double, Size, Size>;
+    using packed_type = packed_symmetric<Size>;
+
+public:
+    /// Construct a view of full matrices
+    explicit voigt_tensor_view(value_type* const full) noexcept : full(full) {}
+
+    /// Construct a view of symmetric matrices in the packed layout
+    explicit voigt_tensor_view(packed_type* const packed) noexcept : packed(packed) {}
+
+    /// \return true if the tensors are stored in the packed layout
+    [[nodiscard]] bool is_packed() const noexcept { return packed != nullptr; }
+
+    /// Refer the quadrature points with a non-zero entry in \p tags to the
+    /// \p shared tensor
+    void share(value_type const* const shared, std::uint8_t* const tags) noexcept
+    {
+        this->shared = shared;
+        this->tags = tags;
+    }
+
+    /// \return the tensor at \p index as a full matrix
+    [[nodiscard]] auto operator[](std::int64_t const index) const -> value_type
+    {
+        if (tags && tags[index]) return *shared;
+
+        return packed ? unpack_symmetric<Size>(packed[index]) : full[index];
+    }
+
+    /// Assign \p value to the tensor at \p index, where only the upper triangle
+    /// is stored in the packed layout
+    void assign(std::int64_t const index, value_type const& value) const
+    {
+        if (tags) tags[index] = 0;
+
+        if (packed)
+        {
+            packed[index] = pack_symmetric<Size>(value);
+        }
+        else
+        {
+            full[index] = value;
+        }
+    }
+
+    /// Assign the shared tensor \p value to the tensor at \p index, which only
+    /// tags the quadrature point when the tensor is shared and otherwise stores
+    /// a copy of \p value
+    void assign_shared(std::int64_t const index, value_type const& value) const
+    {
+        if (tags)
+        {
+            tags[index] = 1;
+            return;
+        }
+        assign(index, value);
+    }
+
+    /// \return the shared tensor if the \p count tensors from the beginning of
+    /// the view all refer to it, otherwise nullptr
+    [[nodiscard]] auto shared_tensor(std::int64_t const count) const noexcept
+        -> value_type const*
+    {
+        if (!tags) return nullptr;
+
+        for (std::int64_t index{0}; index < count; ++index)
+        {
+            if (!tags[index]) return nullptr;
+        }
+        return shared;
+    }
+
+    /// \return a view beginning at the tensor at \p index
+    [[nodiscard]] auto offset(std::int64_t const index) const noexcept -> voigt_tensor_view
+    {
+        auto view = packed ? voigt_tensor_view(packed + index) : voigt_tensor_view(full + index);
+
+        if (tags) view.share(shared, tags + index);
+
+        return view;
+    }
+
+private:
+    value_type* full{nullptr};
+    packed_type* packed{nullptr};
+
+    /// Tensor referred to by the tagged quadrature points
+    value_type const* shared{nullptr};
+    std::uint8_t* tags{nullptr};
+};
+}
@@ -80,6 +80,25 @@ public:
         }
     }
 
+    /// Perform the numerical integration of a lambda function that adds the
+    /// weighted integrand to the accumulator itself.  This avoids creating a
+    /// temporary for the integrand when the accumulator and any workspace
+    /// used by the function have been allocated beforehand.  Scalar factors
+    /// should scale the first operand of a product, for example
+    /// integral.noalias() += (j * w) * N * N.transpose(), since a scaled
+    /// product is otherwise evaluated into a temporary.
+    /// \param integral Value for the numerical integration (accumulated into)
+    /// \param f A lambda function that accepts the accumulator, an femValue,
+    /// the quadrature point and the quadrature weight
+    template <typename IntegralType, typename Callable>
+    void accumulate(IntegralType&& integral, Callable&& f) const
+    {
+        for (std::size_t l{0}; l < points(); ++l)
+        {
+            f(integral, femvals[l], l, m_weights[l]);
+        }
+    }
+
     /// Evaluate the function \p function at each integration point
     /// \tparam A callable type
     template <typename Callable>
@@ -4,6 +4,8 @@
 #include "numeric/float_compare.hpp"
 #include "io/json.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <termcolor/termcolor.hpp>
 
@@ -22,7 +24,8 @@ adaptive_time_step::adaptive_time_step(json const& increment_data,
                 *std::max_element(begin(mandatory_time_history), end(mandatory_time_history)));
 }
 
-void adaptive_time_step::update_convergence_state(bool const is_converged)
+void adaptive_time_step::update_convergence_state(bool const is_converged,
+                                                  std::int32_t const iterations)
 {
     auto constexpr cutback_factor{0.5};
     auto constexpr forward_factor{2.0};
@@ -38,6 +41,8 @@ void adaptive_time_step::update_convergence_state(bool const is_converged)
 
         is_applied = is_approx(current_time, final_time) || time_queue.empty();
 
+        bool const was_cut_back = consecutive_unconverged > 0;
+
         consecutive_unconverged = 0;
         consecutive_converged++;
         successful_increments++;
@@ -46,10 +51,17 @@ void adaptive_time_step::update_convergence_state(bool const is_converged)
 
         // If the previous iterations required cut backs, then the next steps
         // should proceed slowly in the nonlinear region
-        double const new_time = std::min(is_highly_nonlinear()
-                                             ? last_converged_time_step_size + current_time
-                                             : forward_factor * current_time,
-                                         current_time + maximum_increment);
+        double new_time = std::min(is_highly_nonlinear()
+                                       ? last_converged_time_step_size + current_time
+                                       : forward_factor * current_time,
+                                   current_time + maximum_increment);
+
+        if (target_iterations > 0 && iterations > 0)
+        {
+            target_increment = targeted_increment(iterations, was_cut_back);
+
+            new_time = current_time + target_increment;
+        }
 
         current_time = std::min(time_queue.top(), std::min(new_time, final_time));
 
@@ -119,6 +131,21 @@ void adaptive_time_step::parse_input(json const& increment_data, double const ma
     maximum_increment = is_adaptive_increment ? increment_data["increments"]["maximum"].get<double>()
                                               : initial_time;
 
+    auto const& increments_data = increment_data["increments"];
+
+    target_iterations = 0;
+    target_increment = 0.0;
+
+    if (is_adaptive_increment && increments_data.find("iterations") != increments_data.end())
+    {
+        target_iterations = increments_data["iterations"];
+
+        if (target_iterations < 1)
+        {
+            throw std::domain_error("increment iterations must be a positive integer\n");
+        }
+    }
+
     final_time = increment_data["period"];
 
     if (maximum_mandatory_time > final_time)
@@ -163,4 +190,25 @@ bool adaptive_time_step::is_highly_nonlinear() const
 {
     return consecutive_unconverged > 0 || consecutive_converged < 4;
 }
+
+double adaptive_time_step::targeted_increment(std::int32_t const iterations,
+                                              bool const was_cut_back) const
+{
+    auto constexpr minimum_factor{0.5};
+    auto constexpr maximum_factor{2.0};
+
+    // Do not grow the increment straight after a cutback
+    double const factor = std::clamp(std::sqrt(static_cast<double>(target_iterations)
+                                               / iterations),
+                                     minimum_factor,
+                                     was_cut_back ? 1.0 : maximum_factor);
+
+    // An increment shortened to reach a mandatory time continues from the
+    // increment that was computed for the target
+    double const increment = was_cut_back
+                                 ? last_converged_time_step_size
+                                 : std::max(last_converged_time_step_size, target_increment);
+
+    return std::clamp(factor * increment, minimum_increment, maximum_increment);
+}
 }
@@ -66,8 +66,13 @@ namespace neon
  * require the load factor from this algorithm.  If g is the applied value
  * for a Dirichlet condition, then g depends on α (load factor) such that g(α).
  *
- * TODO This class can be extended by including a smart prediction algorithm
- * for the determination of the best next step.
+ * When a target number of nonlinear iterations is given, the next increment
+ * is scaled by the square root of the ratio of the target to the iterations
+ * required by the last increment.  Quickly converging increments are
+ * followed by larger increments and slowly converging increments by smaller
+ * ones, within the minimum and maximum increments and without passing a
+ * mandatory time.  Otherwise the time is doubled after each converged
+ * increment and the increment is held in a highly nonlinear region.
  */
 class adaptive_time_step
 {
@@ -92,8 +97,10 @@ public:
     /// The number of steps taken for all time
     [[nodiscard]] auto step() const noexcept { return successful_increments; }
 
-    /// Update the convergence state to determine the next increment
-    void update_convergence_state(bool const is_converged);
+    /// Update the convergence state to determine the next increment, where
+    /// \p iterations is the number of nonlinear iterations performed and is
+    /// only required for a target number of iterations
+    void update_convergence_state(bool const is_converged, std::int32_t const iterations = 0);
 
     void reset(json const& new_increment_data);
 
@@ -104,6 +111,10 @@ protected:
 
     [[nodiscard]] bool is_highly_nonlinear() const;
 
+    /// \return the next increment from the iterations of the converged increment
+    [[nodiscard]] double targeted_increment(std::int32_t const iterations,
+                                            bool const was_cut_back) const;
+
 protected:
     /// Maximum allowable increments
     std::int32_t const increment_limit{5};
@@ -131,6 +142,11 @@ protected:
     /// Maximum increment allowed by the algorithm
     double maximum_increment;
 
+    /// Nonlinear iterations aimed for in each increment (zero if not used)
+    std::int32_t target_iterations{0};
+    /// Last increment computed for the target before reaching a mandatory time
+    double target_increment{0.0};
+
     bool is_applied{false};
 
     std::priority_queue<double, std::vector<double>, std::greater<double>> time_queue;
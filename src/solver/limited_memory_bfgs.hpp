@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file
+
+#include "numeric/dense_matrix.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace neon
+{
+/// limited_memory_bfgs stores the most recent pairs of solution increments and
+/// residual changes to update the inverse of a factorised tangent matrix with
+/// the Broyden-Fletcher-Goldfarb-Shanno (BFGS) formula.  The inverse is never
+/// formed and is applied through the two loop recursion, where the initial
+/// inverse is the solve with the existing factorisation.  For details see
+/// Matthies and Strang (1979) The solution of nonlinear finite element
+/// equations, International Journal for Numerical Methods in Engineering.
+class limited_memory_bfgs
+{
+public:
+    /// Construct with the number of updates to retain
+    explicit limited_memory_bfgs(std::int32_t const history_size = 10)
+        : history_size(history_size)
+    {
+    }
+
+    /// Remove the stored updates after the matrix is factorised again
+    void clear()
+    {
+        steps.clear();
+        residual_changes.clear();
+        inverse_curvatures.clear();
+    }
+
+    /// \return number of stored updates
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return steps.size(); }
+
+    /// Add the update for the \p step that changed the minus residual from
+    /// \p old_minus_residual to \p minus_residual.  Updates without a positive
+    /// curvature are discarded to keep the inverse positive definite.
+    /// \return true if the update was stored
+    bool push_back(vector const& step,
+                   vector const& old_minus_residual,
+                   vector const& minus_residual)
+    {
+        vector residual_change = old_minus_residual - minus_residual;
+
+        double const curvature = residual_change.dot(step);
+
+        if (curvature <= 1.0e-12 * residual_change.norm() * step.norm()) return false;
+
+        if (static_cast<std::int32_t>(steps.size()) == history_size)
+        {
+            steps.erase(begin(steps));
+            residual_changes.erase(begin(residual_changes));
+            inverse_curvatures.erase(begin(inverse_curvatures));
+        }
+
+        steps.push_back(step);
+        residual_changes.push_back(std::move(residual_change));
+        inverse_curvatures.push_back(1.0 / curvature);
+
+        return true;
+    }
+
+    /// Compute \p x as the product of the updated inverse and \p b where
+    /// \p initial_solve(x, b) applies the inverse of the factorised matrix
+    template <typename SolveFunction>
+    void solve(vector& x, vector const& b, SolveFunction&& initial_solve) const
+    {
+        vector q = b;
+
+        std::vector<double> alpha(steps.size());
+
+        for (auto i = static_cast<std::int64_t>(steps.size()) - 1; i >= 0; --i)
+        {
+            alpha[i] = inverse_curvatures[i] * steps[i].dot(q);
+            q -= alpha[i] * residual_changes[i];
+        }
+
+        initial_solve(x, q);
+
+        for (std::size_t i{0}; i < steps.size(); ++i)
+        {
+            double const beta = inverse_curvatures[i] * residual_changes[i].dot(x);
+            x += (alpha[i] - beta) * steps[i];
+        }
+    }
+
+protected:
+    /// Maximum number of stored updates
+    std::int32_t history_size;
+
+    /// Solution increments
+    std::vector<vector> steps;
+    /// Change in the residual for each solution increment
+    std::vector<vector> residual_changes;
+    /// Inverse of the curvature along each solution increment
+    std::vector<double> inverse_curvatures;
+};
+}
@@ -82,6 +82,23 @@ void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
         throw computational_error("Error in factorisation phase of MUMPS solver\n");
     }
 
+    back_substitution(x);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << std::string(6, ' ') << "MUMPS solver took " << elapsed_seconds.count() << "s\n";
+}
+
+void MUMPS::solve_with_factorisation(vector& x, vector const& b)
+{
+    x = b;
+
+    back_substitution(x);
+}
+
+void MUMPS::back_substitution(vector& x)
+{
     info.rhs = x.data();
     info.nrhs = 1;
     info.lrhs = info.n;
@@ -93,11 +110,6 @@ void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
     {
         throw computational_error("Error in back substitution phase of MUMPS solver\n");
     }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "MUMPS solver took " << elapsed_seconds.count() << "s\n";
 }
 
 void MUMPSLLT::allocate_coordinate_format_storage(sparse_matrix const& A)
@@ -62,6 +62,14 @@ public:
 
     ~MUMPS();
 
+    /// Perform only the back substitution with the existing factorisation
+    void solve_with_factorisation(vector& x, vector const& b) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
 protected:
     /**
      * Expand the sparse matrix into coordinate format only using the upper
@@ -72,6 +80,9 @@ protected:
 
     void internal_solve(sparse_matrix const& A, vector& x, vector const& b);
 
+    /// Solve for the right hand side \p x in place using the factorisation
+    void back_substitution(vector& x);
+
 protected:
     MUMPSAdapter::MUMPS_STRUC_C info;
 
@@ -82,7 +93,7 @@ protected:
 /**
  * MUMPSLLT is the LL^T factorisation (Cholesky) for a symmetric positive
  * definite matrix.  This solver can only be applied on a linear system and
- * takes the lower triangular part of the sparse matrix
+ * takes the upper triangular part of the sparse matrix
  */
 class MUMPSLLT : public MUMPS
 {
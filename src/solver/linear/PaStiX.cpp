@@ -40,6 +40,8 @@ void PaStiXLDLT::solve(sparse_matrix const& A, vector& x, vector const& b)
               << "s\n";
 }
 
+void PaStiXLDLT::solve_with_factorisation(vector& x, vector const& b) { x = ldlt.solve(b); }
+
 PaStiXLU::PaStiXLU()
 {
     // Verbosity
@@ -71,4 +73,6 @@ void PaStiXLU::solve(sparse_matrix const& A, vector& x, vector const& b)
     std::cout << std::string(6, ' ') << "PaStiX LU direct solver took " << elapsed_seconds.count()
               << "s\n";
 }
+
+void PaStiXLU::solve_with_factorisation(vector& x, vector const& b) { x = lu.solve(b); }
 }
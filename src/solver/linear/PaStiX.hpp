@@ -18,6 +18,13 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void solve_with_factorisation(vector& x, vector const& b) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
 private:
     Eigen::PastixLDLT<Eigen::SparseMatrix<double>, Eigen::Upper> ldlt;
 };
@@ -31,6 +38,13 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void solve_with_factorisation(vector& x, vector const& b) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
 private:
     // BUG Likely not going to work with unsymmetric matrix because of row and
     // column ordering change.  Should give the transpose of the matrix but
@@ -56,8 +56,11 @@ void conjugate_gradient_ocl::solve(sparse_matrix const& A, vector& x, vector con
     vcl_sparse_matrix vcl_A(A.rows(), A.cols());
     vcl_vector vcl_b(b.rows());
 
+    // Expand the upper triangle since only the upper triangle may be stored
+    sparse_matrix const A_full(A.selfadjointView<Eigen::Upper>());
+
     // Copy from Eigen objects to ViennaCL objects
-    viennacl::copy(A, vcl_A);
+    viennacl::copy(A_full, vcl_A);
     viennacl::copy(b, vcl_b);
 
     viennacl::linalg::jacobi_precond<vcl_sparse_matrix> vcl_jacobi(vcl_A,
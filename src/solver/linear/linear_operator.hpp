@@ -0,0 +1,28 @@
+#pragma once
+
+/// @file
+
+#include "numeric/dense_matrix.hpp"
+
+#include <cstdint>
+
+namespace neon
+{
+/// linear_operator is the interface for a square linear operator that is only
+/// available through its action on a vector.  This allows a matrix-free
+/// representation of a system where the global matrix is never formed.
+class linear_operator
+{
+public:
+    virtual ~linear_operator() = default;
+
+    /// \return number of rows (and columns) of the operator
+    [[nodiscard]] virtual auto rows() const -> std::int64_t = 0;
+
+    /// Compute the operator vector product \p y = A * \p x
+    virtual void multiply(vector const& x, vector& y) const = 0;
+
+    /// \return the diagonal of the operator for preconditioning
+    [[nodiscard]] virtual auto diagonal() const -> vector const& = 0;
+};
+}
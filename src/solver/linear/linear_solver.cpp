@@ -3,6 +3,7 @@
 #define NEON_PARALLEL_EIGEN_SOLVERS
 
 #include "linear_solver.hpp"
+#include "preconditioned_conjugate_gradient.hpp"
 
 #include "exceptions.hpp"
 #include "simulation_parser.hpp"
@@ -17,9 +18,32 @@
 #include <chrono>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 
 namespace neon
 {
+void linear_solver::solve(block_sparse_matrix<2> const& A, vector& x, vector const& b)
+{
+    this->solve(A.to_sparse(), x, b);
+}
+
+void linear_solver::solve(block_sparse_matrix<3> const& A, vector& x, vector const& b)
+{
+    this->solve(A.to_sparse(), x, b);
+}
+
+void linear_solver::solve(linear_operator const&, vector&, vector const&)
+{
+    throw std::domain_error("Matrix-free operators require an \"iterative\" linear solver on the "
+                            "\"cpu\" device");
+}
+
+void linear_solver::solve_with_factorisation(vector&, vector const&)
+{
+    throw std::domain_error("Reusing the factorisation requires a \"direct\" or an \"iterative\" "
+                            "linear solver on the \"cpu\" device");
+}
+
 iterative_linear_solver::iterative_linear_solver(double const residual_tolerance)
     : residual_tolerance{residual_tolerance}
 {
@@ -39,7 +63,8 @@ iterative_linear_solver::iterative_linear_solver(double const residual_tolerance
 void iterative_linear_solver::apply_permutation(sparse_matrix const& input_matrix,
                                                 vector const& input_rhs)
 {
-    A = P.transpose() * input_matrix * P;
+    // Only the upper triangle is referenced such that symmetric storage is accepted
+    A = input_matrix.selfadjointView<Eigen::Upper>().twistedBy(P_inverse);
     b = P.transpose() * input_rhs;
 }
 
@@ -47,7 +72,7 @@ void iterative_linear_solver::compute_symmetric_reordering(sparse_matrix const&
 {
     auto const start = std::chrono::steady_clock::now();
 
-    reverse_cuthill_mcgee reordering(input_matrix);
+    reverse_cuthill_mcgee reordering(sparse_matrix(input_matrix.selfadjointView<Eigen::Upper>()));
 
     reordering.compute();
 
@@ -57,6 +82,8 @@ void iterative_linear_solver::compute_symmetric_reordering(sparse_matrix const&
 
     std::copy(begin(permutation), end(permutation), P.indices().data());
 
+    P_inverse = P.inverse();
+
     build_sparsity_pattern = false;
 
     std::chrono::duration<double> const elapsed_seconds = std::chrono::steady_clock::now() - start;
@@ -66,14 +93,6 @@ void iterative_linear_solver::compute_symmetric_reordering(sparse_matrix const&
 
 void conjugate_gradient::solve(sparse_matrix const& input_matrix, vector& x, vector const& input_rhs)
 {
-#ifdef ENABLE_OPENMP
-    omp_set_num_threads(simulation_parser::threads);
-#endif
-
-    std::feclearexcept(FE_ALL_EXCEPT);
-
-    auto const start = std::chrono::steady_clock::now();
-
     if (build_sparsity_pattern)
     {
         compute_symmetric_reordering(input_matrix);
@@ -82,9 +101,30 @@ void conjugate_gradient::solve(sparse_matrix const& input_matrix, vector& x, vec
 
     apply_permutation(input_matrix, input_rhs);
 
+    solve_reordered(x);
+}
+
+void conjugate_gradient::solve_with_factorisation(vector& x, vector const& input_rhs)
+{
+    // The reordered matrix from the last solve is retained
+    b = P.transpose() * input_rhs;
+
+    solve_reordered(x);
+}
+
+void conjugate_gradient::solve_reordered(vector& x)
+{
+#ifdef ENABLE_OPENMP
+    omp_set_num_threads(simulation_parser::threads);
+#endif
+
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    auto const start = std::chrono::steady_clock::now();
+
     Eigen::ConjugateGradient<sparse_matrix, Eigen::Lower | Eigen::Upper> pcg;
 
-    pcg.setTolerance(residual_tolerance);
+    pcg.setTolerance(tolerance());
     pcg.setMaxIterations(max_iterations);
 
     x = P * pcg.compute(A).solve(b);
@@ -94,7 +134,7 @@ void conjugate_gradient::solve(sparse_matrix const& input_matrix, vector& x, vec
 
     std::cout << std::string(6, ' ') << "Conjugate gradient took " << elapsed_seconds.count()
               << "s, iterations: " << pcg.iterations() << " (max. " << max_iterations
-              << "), estimated error: " << pcg.error() << " (min. " << residual_tolerance << ")\n";
+              << "), estimated error: " << pcg.error() << " (min. " << tolerance() << ")\n";
 
     if (std::fetestexcept(FE_INVALID))
     {
@@ -108,13 +148,61 @@ void conjugate_gradient::solve(sparse_matrix const& input_matrix, vector& x, vec
     }
 }
 
+void conjugate_gradient::solve(block_sparse_matrix<2> const& A, vector& x, vector const& b)
+{
+    solve_operator(A, x, b);
+}
+
+void conjugate_gradient::solve(block_sparse_matrix<3> const& A, vector& x, vector const& b)
+{
+    solve_operator(A, x, b);
+}
+
+void conjugate_gradient::solve(linear_operator const& A, vector& x, vector const& b)
+{
+    solve_operator(A, x, b);
+}
+
+template <typename operator_type>
+void conjugate_gradient::solve_operator(operator_type const& A, vector& x, vector const& b)
+{
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto const [iterations, error] = preconditioned_conjugate_gradient(A,
+                                                                       A.diagonal(),
+                                                                       x,
+                                                                       b,
+                                                                       tolerance(),
+                                                                       max_iterations);
+
+    auto const end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> const elapsed_seconds = end - start;
+
+    std::cout << std::string(6, ' ') << "Jacobi conjugate gradient took " << elapsed_seconds.count()
+              << "s, iterations: " << iterations << " (max. " << max_iterations
+              << "), estimated error: " << error << " (min. " << tolerance() << ")\n";
+
+    if (std::fetestexcept(FE_INVALID))
+    {
+        throw computational_error("Floating point error reported\n");
+    }
+
+    if (iterations >= max_iterations)
+    {
+        throw computational_error("Conjugate gradient solver maximum iterations "
+                                  "reached");
+    }
+}
+
 void biconjugate_gradient_stabilised::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
     std::feclearexcept(FE_ALL_EXCEPT);
 
     Eigen::BiCGSTAB<sparse_matrix> bicgstab; //, Eigen::IncompleteLUT<double>
 
-    bicgstab.setTolerance(residual_tolerance);
+    bicgstab.setTolerance(tolerance());
     bicgstab.setMaxIterations(max_iterations);
 
     bicgstab.compute(A);
@@ -134,7 +222,7 @@ void biconjugate_gradient_stabilised::solve(sparse_matrix const& A, vector& x, v
 
     std::cout << std::string(6, ' ') << "Conjugate gradient iterations: " << bicgstab.iterations()
               << " (max. " << max_iterations << "), estimated error: " << bicgstab.error()
-              << " (min. " << residual_tolerance << ")\n";
+              << " (min. " << tolerance() << ")\n";
 }
 
 void SparseLU::solve(sparse_matrix const& A, vector& x, vector const& b)
@@ -148,6 +236,8 @@ void SparseLU::solve(sparse_matrix const& A, vector& x, vector const& b)
     x = lu.solve(b);
 }
 
+void SparseLU::solve_with_factorisation(vector& x, vector const& b) { x = lu.solve(b); }
+
 void SparseLLT::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
     if (build_sparsity_pattern)
@@ -158,4 +248,6 @@ void SparseLLT::solve(sparse_matrix const& A, vector& x, vector const& b)
     llt.factorize(A);
     x = llt.solve(b);
 }
+
+void SparseLLT::solve_with_factorisation(vector& x, vector const& b) { x = llt.solve(b); }
 }
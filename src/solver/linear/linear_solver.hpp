@@ -3,9 +3,13 @@
 
 /// @file
 
+#include "linear_operator.hpp"
+#include "numeric/block_sparse_matrix.hpp"
 #include "numeric/dense_matrix.hpp"
 #include "numeric/sparse_matrix.hpp"
 
+#include <algorithm>
+
 namespace neon
 {
 /// linear_solver is to setup a linear solver with designated parameters from
@@ -15,8 +19,37 @@ class linear_solver
 public:
     virtual ~linear_solver() = default;
 
+    /// Solve the linear system A x = b.  Solvers for symmetric systems only
+    /// reference the upper triangle of \p A, which allows the upper triangle
+    /// alone to be stored (\sa compute_upper_sparsity_pattern)
     virtual void solve(sparse_matrix const& A, vector& x, vector const& b) = 0;
 
+    /// Solve with a block compressed matrix.  Solvers without native support
+    /// for the block format solve a compressed row copy of the matrix.
+    virtual void solve(block_sparse_matrix<2> const& A, vector& x, vector const& b);
+
+    /// \sa solve(block_sparse_matrix<2> const&, vector&, vector const&)
+    virtual void solve(block_sparse_matrix<3> const& A, vector& x, vector const& b);
+
+    /// Solve with a matrix-free operator.  This is only supported by the
+    /// iterative solvers on the CPU and otherwise throws std::domain_error.
+    virtual void solve(linear_operator const& A, vector& x, vector const& b);
+
+    /// Solve A x = b for a new right hand side using the factorisation of the
+    /// matrix given in the last call to solve(sparse_matrix const&, ...), such
+    /// that an unchanged matrix is not factorised again.  This throws
+    /// std::domain_error for solvers without this support.
+    /// \sa is_factorisation_reusable
+    virtual void solve_with_factorisation(vector& x, vector const& b);
+
+    /// \return true if the solver supports solve_with_factorisation
+    [[nodiscard]] virtual auto is_factorisation_reusable() const noexcept -> bool { return false; }
+
+    /// Relax the relative residual tolerance of the following solves to
+    /// \p forcing_term for an inexact Newton method.  The tolerance given on
+    /// construction remains the lower bound.  Direct solvers ignore this.
+    virtual void set_forcing_term(double const) {}
+
     /// Notifies the linear solvers of a change in sparsity structure of A
     void update_sparsity_pattern() { build_sparsity_pattern = true; }
 
@@ -40,7 +73,15 @@ public:
     explicit iterative_linear_solver(double const residual_tolerance,
                                      std::int32_t const max_iterations);
 
+    void set_forcing_term(double const forcing_term) override { this->forcing_term = forcing_term; }
+
 protected:
+    /// \return the relative residual tolerance for the next solve
+    [[nodiscard]] auto tolerance() const noexcept -> double
+    {
+        return std::max(residual_tolerance, forcing_term);
+    }
+
     void compute_symmetric_reordering(sparse_matrix const& input_matrix);
 
     void apply_permutation(sparse_matrix const& input_matrix, vector const& input_rhs);
@@ -49,10 +90,13 @@ protected:
     double residual_tolerance{1.0e-5};
     std::int32_t max_iterations{2000};
 
+    /// Relative residual tolerance requested by an inexact Newton method
+    double forcing_term{0.0};
+
     sparse_matrix A;
     vector b;
 
-    permutation_matrix P;
+    permutation_matrix P, P_inverse;
 };
 
 /// conjugate_gradient is a simple solver wrapper for the preconditioned conjugate gradient
@@ -68,6 +112,32 @@ public:
     using iterative_linear_solver::iterative_linear_solver;
 
     void solve(sparse_matrix const& input_matrix, vector& x, vector const& input_rhs) override final;
+
+    /// Solve directly with the block matrix using the block matrix vector product
+    void solve(block_sparse_matrix<2> const& A, vector& x, vector const& b) override final;
+
+    /// Solve directly with the block matrix using the block matrix vector product
+    void solve(block_sparse_matrix<3> const& A, vector& x, vector const& b) override final;
+
+    /// Solve using the operator vector product and the operator diagonal
+    void solve(linear_operator const& A, vector& x, vector const& b) override final;
+
+    /// Solve using the reordered matrix from the last compressed matrix solve
+    void solve_with_factorisation(vector& x, vector const& input_rhs) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
+private:
+    /// Solve the reordered system stored in A and b
+    void solve_reordered(vector& x);
+
+    /// Solve using the Jacobi preconditioned conjugate gradient method for an
+    /// operator providing the matrix vector product and the diagonal
+    template <typename operator_type>
+    void solve_operator(operator_type const& A, vector& x, vector const& b);
 };
 
 /// biconjugate_gradient_stabilised is a simple solver wrapper for the preconditioned bi-conjugate gradient
@@ -97,6 +167,13 @@ class SparseLU : public direct_linear_solver
 public:
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void solve_with_factorisation(vector& x, vector const& b) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
 private:
     Eigen::SparseLU<sparse_matrix, Eigen::AMDOrdering<std::int32_t>> lu;
 };
@@ -109,7 +186,14 @@ class SparseLLT : public direct_linear_solver
 public:
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void solve_with_factorisation(vector& x, vector const& b) override final;
+
+    [[nodiscard]] auto is_factorisation_reusable() const noexcept -> bool override final
+    {
+        return true;
+    }
+
 private:
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<sparse_matrix::Scalar>> llt;
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<sparse_matrix::Scalar>, Eigen::Upper> llt;
 };
 }
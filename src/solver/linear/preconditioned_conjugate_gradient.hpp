@@ -0,0 +1,83 @@
+#pragma once
+
+/// @file
+
+#include "numeric/dense_matrix.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace neon
+{
+/// Solve the symmetric positive definite system A x = b using the conjugate
+/// gradient method with a diagonal (Jacobi) preconditioner starting from a
+/// zero initial guess.  The operator only needs to provide the matrix vector
+/// product through a \p multiply(x, y) method computing y = A x, which allows
+/// any storage format or a matrix-free operator to be used.
+/// \param A Linear operator
+/// \param diagonal Diagonal of the operator for the preconditioner
+/// \param x Solution vector
+/// \param b Right hand side vector
+/// \param residual_tolerance Relative residual tolerance |r| / |b|
+/// \param max_iterations Maximum number of iterations to perform
+/// \return the number of iterations and the estimated relative error
+template <typename operator_type>
+auto preconditioned_conjugate_gradient(operator_type const& A,
+                                       vector const& diagonal,
+                                       vector& x,
+                                       vector const& b,
+                                       double const residual_tolerance,
+                                       std::int32_t const max_iterations)
+    -> std::pair<std::int32_t, double>
+{
+    x = vector::Zero(b.size());
+
+    double const rhs_norm = b.squaredNorm();
+
+    if (rhs_norm == 0.0) return {0, 0.0};
+
+    // Avoid division by zero for rows without a diagonal entry
+    vector const inverse_diagonal = (diagonal.array() == 0.0).select(1.0, diagonal.cwiseInverse());
+
+    double const threshold = residual_tolerance * residual_tolerance * rhs_norm;
+
+    vector residual = b;
+
+    double residual_norm = residual.squaredNorm();
+
+    if (residual_norm < threshold) return {0, std::sqrt(residual_norm / rhs_norm)};
+
+    vector direction = inverse_diagonal.cwiseProduct(residual);
+    vector z(b.size()), product(b.size());
+
+    double absolute_new = residual.dot(direction);
+
+    std::int32_t iteration{0};
+
+    while (iteration < max_iterations)
+    {
+        A.multiply(direction, product);
+
+        double const alpha = absolute_new / direction.dot(product);
+
+        x += alpha * direction;
+        residual -= alpha * product;
+
+        residual_norm = residual.squaredNorm();
+
+        if (residual_norm < threshold) break;
+
+        z = inverse_diagonal.cwiseProduct(residual);
+
+        double const absolute_old = absolute_new;
+
+        absolute_new = residual.dot(z);
+
+        direction = z + (absolute_new / absolute_old) * direction;
+
+        ++iteration;
+    }
+    return {iteration, std::sqrt(residual_norm / rhs_norm)};
+}
+}
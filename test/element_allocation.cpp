@@ -0,0 +1,250 @@
+
+#include <catch2/catch.hpp>
+
+#include "interpolations/hexahedron.hpp"
+#include "mesh/basic_mesh.hpp"
+#include "mesh/material_coordinates.hpp"
+#include "mesh/mechanics/solid/submesh.hpp"
+#include "mesh/mechanics/plane/submesh.hpp"
+#include "mesh/diffusion/heat/submesh.hpp"
+#include "mesh/diffusion/reaction/submesh.hpp"
+#include "io/json.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GLIBC__)
+
+// Eigen allocates with std::malloc instead of operator new, so the heap
+// allocations are counted by interposing the C allocation functions and
+// forwarding to the glibc implementation.  Only allocations made by a thread
+// with counting enabled are recorded.
+
+extern "C" void* __libc_malloc(std::size_t);
+extern "C" void* __libc_calloc(std::size_t, std::size_t);
+extern "C" void* __libc_realloc(void*, std::size_t);
+
+namespace
+{
+std::atomic<std::int64_t> allocations{0};
+
+thread_local bool is_counting{false};
+
+void count_allocation()
+{
+    if (is_counting) ++allocations;
+}
+}
+
+extern "C" void* malloc(std::size_t const size)
+{
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t const count, std::size_t const size)
+{
+    count_allocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* const pointer, std::size_t const size)
+{
+    count_allocation();
+    return __libc_realloc(pointer, size);
+}
+
+/// \return the number of heap allocations made by \p function on this thread
+template <typename Callable>
+std::int64_t count_allocations(Callable&& function)
+{
+    allocations = 0;
+    is_counting = true;
+    function();
+    is_counting = false;
+    return allocations;
+}
+
+using namespace neon;
+
+TEST_CASE("Quadrature accumulation allocations")
+{
+    hexahedron8 hex8(hexahedron_quadrature::point::eight);
+
+    matrix integral(8, 8);
+
+    auto const accumulate_mass = [&] {
+        hex8.quadrature().accumulate(integral.setZero(),
+                                     [](auto& m, auto const& femval, auto, auto const w) {
+                                         auto const& [N, dN] = femval;
+
+                                         m.noalias() += (w * N) * N.transpose();
+                                     });
+    };
+
+    REQUIRE(count_allocations(accumulate_mass) == 0);
+
+    // Each shape function sums to one and the reference volume is eight
+    REQUIRE(integral.sum() == Approx(8.0));
+}
+
+TEST_CASE("Solid submesh element allocations")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+    nodal_coordinates nodal_coordinates(json::parse(json_cube_mesh()));
+
+    auto& submesh = basic_mesh.meshes("cube")[0];
+
+    auto mesh_coordinates = std::make_shared<material_coordinates>(nodal_coordinates.coordinates());
+
+    mechanics::solid::submesh fem_submesh(json::parse(material_data_json()),
+                                          json::parse(simulation_data_json()),
+                                          mesh_coordinates,
+                                          submesh);
+
+    mesh_coordinates->update_current_configuration(0.001 * vector::Random(64 * 3));
+
+    fem_submesh.update_internal_variables();
+
+    vector const u = vector::Random(8 * 3);
+
+    double checksum{0.0};
+
+    auto const evaluate_elements = [&] {
+        for (std::int64_t element{0}; element < fem_submesh.elements(); ++element)
+        {
+            checksum += fem_submesh.tangent_stiffness(element)(0, 0);
+            checksum += fem_submesh.symmetric_tangent_stiffness(element)(0, 0);
+            checksum += fem_submesh.tangent_stiffness_and_internal_force(element, false).second(0);
+            checksum += fem_submesh.tangent_stiffness_product(element, u)(0);
+            checksum += fem_submesh.tangent_stiffness_diagonal(element)(0);
+            checksum += fem_submesh.internal_force(element)(0);
+            checksum += fem_submesh.consistent_mass(element)(0, 0);
+        }
+    };
+
+    // The first evaluation allocates the thread local element storage
+    evaluate_elements();
+
+    REQUIRE(count_allocations(evaluate_elements) == 0);
+    REQUIRE(std::isfinite(checksum));
+}
+
+TEST_CASE("Plane submesh element allocations")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+    nodal_coordinates nodal_coordinates(json::parse(json_cube_mesh()));
+
+    // The quadrilateral faces on the bottom of the cube form a plane mesh
+    auto& submesh = basic_mesh.meshes("bottom")[0];
+
+    auto mesh_coordinates = std::make_shared<material_coordinates>(nodal_coordinates.coordinates());
+
+    auto simulation_data = json::parse(simulation_data_json());
+    simulation_data["constitutive"] = json::parse("{\"name\" : \"plane_strain\"}");
+
+    mechanics::plane::submesh fem_submesh(json::parse(material_data_json()),
+                                          simulation_data,
+                                          mesh_coordinates,
+                                          submesh);
+
+    mesh_coordinates->update_current_configuration(0.001 * vector::Random(64 * 3));
+
+    fem_submesh.update_internal_variables();
+
+    vector const u = vector::Random(4 * 2);
+
+    double checksum{0.0};
+
+    auto const evaluate_elements = [&] {
+        for (std::int64_t element{0}; element < fem_submesh.elements(); ++element)
+        {
+            checksum += fem_submesh.tangent_stiffness(element)(0, 0);
+            checksum += fem_submesh.symmetric_tangent_stiffness(element)(0, 0);
+            checksum += fem_submesh.tangent_stiffness_and_internal_force(element, false).second(0);
+            checksum += fem_submesh.tangent_stiffness_product(element, u)(0);
+            checksum += fem_submesh.tangent_stiffness_diagonal(element)(0);
+            checksum += fem_submesh.internal_force(element)(0);
+            checksum += fem_submesh.diagonal_mass(element)(0);
+        }
+    };
+
+    // The first evaluation allocates the thread local element storage
+    evaluate_elements();
+
+    REQUIRE(count_allocations(evaluate_elements) == 0);
+    REQUIRE(std::isfinite(checksum));
+}
+
+/// Require that the element matrices of the diffusion \p fem_submesh do not
+/// allocate once the thread local element storage has been allocated
+template <typename DiffusionSubmesh>
+void require_allocation_free_diffusion_elements(DiffusionSubmesh const& fem_submesh)
+{
+    double checksum{0.0};
+
+    auto const evaluate_elements = [&] {
+        for (std::int64_t element{0}; element < fem_submesh.elements(); ++element)
+        {
+            checksum += fem_submesh.tangent_stiffness(element).second(0, 0);
+            checksum += fem_submesh.consistent_mass(element).second(0, 0);
+            checksum += fem_submesh.diagonal_mass(element).second(0);
+        }
+    };
+
+    evaluate_elements();
+
+    REQUIRE(count_allocations(evaluate_elements) == 0);
+    REQUIRE(std::isfinite(checksum));
+}
+
+TEST_CASE("Diffusion submesh element allocations")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+    nodal_coordinates nodal_coordinates(json::parse(json_cube_mesh()));
+
+    auto& submesh = basic_mesh.meshes("cube")[0];
+
+    auto mesh_coordinates = std::make_shared<material_coordinates>(nodal_coordinates.coordinates());
+
+    auto const material_data = json::parse("{\"name\": \"steel\", "
+                                           "\"conductivity\": 386.0, "
+                                           "\"density\": 7800.0, "
+                                           "\"specific_heat\": 390.0}");
+
+    auto simulation_data = json::parse(simulation_data_json());
+    simulation_data["constitutive"] = json::parse("{\"name\" : \"isotropic_diffusion\"}");
+
+    SECTION("Heat")
+    {
+        diffusion::submesh fem_submesh(material_data, simulation_data, mesh_coordinates, submesh);
+
+        fem_submesh.update_internal_variables(1.0);
+
+        require_allocation_free_diffusion_elements(fem_submesh);
+    }
+    SECTION("Reaction")
+    {
+        diffusion::reaction::submesh fem_submesh(material_data,
+                                                 simulation_data,
+                                                 mesh_coordinates,
+                                                 submesh);
+
+        fem_submesh.update_internal_variables(1.0);
+
+        require_allocation_free_diffusion_elements(fem_submesh);
+    }
+}
+
+#else
+
+TEST_CASE("Submesh element allocations")
+{
+    WARN("Heap allocations are only counted with the GNU C library");
+}
+
+#endif
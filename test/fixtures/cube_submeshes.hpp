@@ -0,0 +1,88 @@
+#pragma once
+
+/// @file
+
+#include "cube_mesh.hpp"
+
+#include "io/json.hpp"
+#include "mesh/basic_mesh.hpp"
+#include "mesh/material_coordinates.hpp"
+#include "mesh/mechanics/solid/submesh.hpp"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+/// cube_submeshes constructs a solid submesh of the cube mesh for each set of
+/// element options, which are added to the element options of the cube
+/// simulation data.  All submeshes share the nodal coordinates such that each
+/// deformation is applied to every submesh.
+class cube_submeshes
+{
+public:
+    using submesh_type = neon::mechanics::solid::submesh;
+
+public:
+    /// Construct a submesh for each of the \p element_options with the
+    /// \p material_data and optionally the \p constitutive model, which
+    /// defaults to the model of the cube simulation data
+    explicit cube_submeshes(std::vector<neon::json> const& element_options,
+                            neon::json const& material_data = neon::json::parse(material_data_json()),
+                            neon::json const& constitutive = neon::json())
+        : basic_mesh(neon::json::parse(json_cube_mesh())),
+          nodal_coordinates(neon::json::parse(json_cube_mesh())),
+          coordinates(std::make_shared<neon::material_coordinates>(nodal_coordinates.coordinates()))
+    {
+        for (auto const& options : element_options)
+        {
+            auto simulation_data = neon::json::parse(simulation_data_json());
+
+            for (auto option = options.begin(); option != options.end(); ++option)
+            {
+                simulation_data["element_options"][option.key()] = option.value();
+            }
+            if (!constitutive.is_null()) simulation_data["constitutive"] = constitutive;
+
+            submeshes.emplace_back(material_data,
+                                   simulation_data,
+                                   coordinates,
+                                   basic_mesh.meshes("cube")[0]);
+        }
+    }
+
+    /// \return the submesh constructed with the element options at \p index
+    [[nodiscard]] auto operator[](std::size_t const index) -> submesh_type&
+    {
+        return submeshes[index];
+    }
+
+    /// \return the nodal coordinates shared by the submeshes
+    [[nodiscard]] auto mesh_coordinates() -> neon::material_coordinates&
+    {
+        return *coordinates;
+    }
+
+    /// Displace the nodes by \p u and update the internal variables of each
+    /// submesh
+    void deform(neon::vector const& u)
+    {
+        coordinates->update_current_configuration(u);
+
+        for (auto& submesh : submeshes) submesh.update_internal_variables();
+    }
+
+    /// Displace the nodes by a random perturbation of size \p scale and update
+    /// the internal variables of each submesh
+    void perturb(double const scale = 0.001)
+    {
+        deform(scale * neon::vector::Random(coordinates->coordinates().size()));
+    }
+
+private:
+    neon::basic_mesh basic_mesh;
+    neon::nodal_coordinates nodal_coordinates;
+
+    std::shared_ptr<neon::material_coordinates> coordinates;
+
+    std::deque<submesh_type> submeshes;
+};
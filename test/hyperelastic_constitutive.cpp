@@ -12,6 +12,7 @@
 
 #include <Eigen/Eigenvalues>
 
+#include <cstdint>
 #include <iostream>
 
 std::string json_input_file()
@@ -25,6 +26,199 @@ constexpr auto ZERO_MARGIN = 1.0e-5;
 using neon::json;
 using namespace neon;
 
+TEST_CASE("Internal variable storage")
+{
+    using namespace neon::mechanics::solid;
+
+    internal_variables_t variables(internal_variable_size);
+
+    variables.add(variable::second::deformation_gradient);
+    variables.add(variable::scalar::DetF, 1.0);
+    variables.add(variable::fourth::tangent_operator);
+
+    variables.mark_history(variable::second::deformation_gradient);
+    variables.mark_history(variable::scalar::DetF);
+
+    auto const is_aligned = [](void const* pointer) {
+        return reinterpret_cast<std::uintptr_t>(pointer) % storage_alignment == 0;
+    };
+
+    SECTION("Allocation")
+    {
+        REQUIRE(variables.has(variable::second::deformation_gradient));
+        REQUIRE(variables.has(variable::scalar::DetF));
+        REQUIRE(variables.has(variable::fourth::tangent_operator));
+
+        REQUIRE_FALSE(variables.has(variable::second::cauchy_stress));
+        REQUIRE_FALSE(variables.has(variable::scalar::damage));
+
+        REQUIRE_THROWS_AS(variables.get(variable::second::cauchy_stress), std::domain_error);
+        REQUIRE_THROWS_AS(variables.get(variable::scalar::damage), std::domain_error);
+
+        REQUIRE(is_aligned(variables.get(variable::second::deformation_gradient).data()));
+        REQUIRE(is_aligned(variables.get(variable::scalar::DetF).data()));
+        REQUIRE(is_aligned(variables.get(variable::fourth::tangent_operator).data()));
+    }
+    SECTION("History allocation")
+    {
+        auto const bytes = variables.allocated_bytes();
+        auto const history_bytes = variables.history_bytes();
+
+        REQUIRE(history_bytes == internal_variable_size * (sizeof(matrix3) + sizeof(double)));
+
+        // Variables without history are only stored once
+        variables.add(variable::second::cauchy_stress);
+
+        REQUIRE(variables.allocated_bytes() == bytes + internal_variable_size * sizeof(matrix3));
+        REQUIRE(variables.history_bytes() == history_bytes);
+
+        REQUIRE_FALSE(variables.has_history(variable::second::cauchy_stress));
+        REQUIRE_THROWS_AS(variables.get_old(variable::second::cauchy_stress), std::domain_error);
+
+        // History can be declared after the variable is added
+        variables.mark_history(variable::second::cauchy_stress);
+
+        REQUIRE(variables.has_history(variable::second::cauchy_stress));
+        REQUIRE(variables.history_bytes()
+                == history_bytes + internal_variable_size * sizeof(matrix3));
+    }
+    SECTION("Commit and revert")
+    {
+        auto& J_list = variables.get(variable::scalar::DetF);
+
+        variables.advance();
+        J_list[0] = 2.0;
+        variables.commit();
+
+        REQUIRE(J_list[0] == Approx(2.0));
+        REQUIRE(variables.get_old(variable::scalar::DetF)[0] == Approx(2.0));
+
+        // The converged values are copied into the next increment
+        variables.advance();
+
+        REQUIRE(J_list[0] == Approx(2.0));
+        REQUIRE(variables.get_old(variable::scalar::DetF)[0] == Approx(2.0));
+
+        J_list[0] = 3.0;
+        variables.revert();
+
+        REQUIRE(J_list[0] == Approx(2.0));
+        REQUIRE(variables.get_old(variable::scalar::DetF)[0] == Approx(2.0));
+
+        // A revert without an update leaves the converged values
+        variables.revert();
+
+        REQUIRE(J_list[0] == Approx(2.0));
+    }
+    SECTION("Recomputed variables")
+    {
+        variables.mark_recomputed(variable::scalar::DetF);
+
+        auto& J_list = variables.get(variable::scalar::DetF);
+
+        variables.advance();
+        J_list[0] = 2.0;
+        variables.commit();
+
+        variables.advance();
+
+        // Only the converged generation holds the committed values
+        REQUIRE(J_list[0] == Approx(1.0));
+        REQUIRE(variables.get_old(variable::scalar::DetF)[0] == Approx(2.0));
+    }
+    SECTION("Structure of arrays layout")
+    {
+        REQUIRE_FALSE(variables.has_components(variable::second::deformation_gradient));
+        REQUIRE_THROWS_AS(variables.components(variable::second::deformation_gradient),
+                          std::domain_error);
+
+        variables.add_components(variable::second::deformation_gradient);
+
+        variables.advance();
+
+        auto F_components = variables.components(variable::second::deformation_gradient);
+
+        REQUIRE(F_components.rows() == internal_variable_size);
+        REQUIRE(F_components.cols() == 9);
+
+        for (Eigen::Index component{0}; component < F_components.cols(); ++component)
+        {
+            REQUIRE(is_aligned(F_components.col(component).data()));
+        }
+
+        matrix3 const F = matrix3::Random();
+
+        F_components.row(1) = Eigen::Map<Eigen::Matrix<double, 1, 9> const>(F.data());
+
+        variables.commit();
+        variables.advance();
+
+        // A map refers to the storage of one generation and is retrieved again
+        variables.components(variable::second::deformation_gradient).setZero();
+
+        variables.revert();
+
+        auto const F_reverted = variables.components(variable::second::deformation_gradient);
+
+        REQUIRE(variables.components_old(variable::second::deformation_gradient)
+                    .isApprox(F_reverted));
+
+        REQUIRE(Eigen::Map<matrix3 const>(F_reverted.row(1).eval().data()).isApprox(F));
+    }
+    SECTION("Packed fourth order tensors")
+    {
+        matrix6 const C = matrix6::Random();
+        matrix6 const D = C + C.transpose();
+
+        auto& full_tangents = variables.get(variable::fourth::tangent_operator);
+
+        std::fill(begin(full_tangents), end(full_tangents), D);
+
+        variables.pack(variable::fourth::tangent_operator);
+
+        REQUIRE(variables.has(variable::fourth::tangent_operator));
+        REQUIRE(variables.is_packed(variable::fourth::tangent_operator));
+        REQUIRE_THROWS_AS(variables.get(variable::fourth::tangent_operator), std::domain_error);
+
+        auto const tangents = variables.voigt_view(variable::fourth::tangent_operator);
+
+        REQUIRE(tangents.is_packed());
+        REQUIRE(tangents[internal_variable_size - 1].isApprox(D));
+
+        tangents.assign(1, 2.0 * D);
+
+        REQUIRE(tangents[1].isApprox(2.0 * D));
+        REQUIRE(tangents.offset(1)[0].isApprox(2.0 * D));
+    }
+    SECTION("Shared fourth order tensors")
+    {
+        matrix6 const C = matrix6::Identity();
+
+        variables.share(variable::fourth::tangent_operator, C);
+
+        REQUIRE(variables.is_shared(variable::fourth::tangent_operator));
+        REQUIRE_THROWS_AS(variables.get(variable::fourth::tangent_operator), std::domain_error);
+
+        auto const tangents = variables.voigt_view(variable::fourth::tangent_operator);
+
+        REQUIRE(tangents.shared_tensor(internal_variable_size) == nullptr);
+
+        for (std::int64_t l{0}; l < internal_variable_size; ++l)
+        {
+            tangents.assign_shared(l, C);
+        }
+
+        REQUIRE(tangents.shared_tensor(internal_variable_size) != nullptr);
+        REQUIRE(tangents[internal_variable_size - 1].isApprox(C));
+
+        tangents.assign(0, 2.0 * C);
+
+        REQUIRE(tangents[0].isApprox(2.0 * C));
+        REQUIRE(tangents.shared_tensor(internal_variable_size) == nullptr);
+        REQUIRE(tangents.offset(1).shared_tensor(internal_variable_size - 1) != nullptr);
+    }
+}
+
 TEST_CASE("Neo-Hookean model")
 {
     using namespace neon::mechanics::solid;
@@ -213,6 +407,41 @@ TEST_CASE("Gaussian affine microsphere")
             REQUIRE(cauchy_stress.norm() > 0.0);
         }
     }
+    SECTION("stress update without the tangent")
+    {
+        for (auto& F : F_list)
+        {
+            F(0, 0) = 1.1;
+            F(1, 1) = 1.0 / std::sqrt(1.1);
+            F(2, 2) = 1.0 / std::sqrt(1.1);
+        }
+
+        affine->update_internal_variables(1.0);
+
+        auto const expected_stresses = cauchy_stresses;
+        auto const expected_tangents = material_tangents;
+
+        for (auto& cauchy_stress : cauchy_stresses) cauchy_stress.setZero();
+
+        affine->update_stress(1.0);
+
+        for (std::size_t l{0}; l < cauchy_stresses.size(); ++l)
+        {
+            REQUIRE((cauchy_stresses[l] - expected_stresses[l]).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+
+        // A full update after a stress update computes the tangent again
+        for (auto& material_tangent : material_tangents) material_tangent.setZero();
+
+        affine->update_internal_variables(1.0);
+
+        for (std::size_t l{0}; l < material_tangents.size(); ++l)
+        {
+            REQUIRE((material_tangents[l] - expected_tangents[l]).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
 }
 TEST_CASE("Affine microsphere")
 {
@@ -2,8 +2,10 @@
 #include <catch2/catch.hpp>
 
 #include "solver/linear/linear_solver_factory.hpp"
+#include "numeric/block_sparse_matrix.hpp"
 
 #include <stdexcept>
+#include <utility>
 
 #include "io/json.hpp"
 
@@ -215,3 +217,140 @@ TEST_CASE("Linear solver test suite")
         REQUIRE_THROWS_AS(make_linear_solver(solver_data), std::domain_error);
     }
 }
+TEST_CASE("Upper triangular storage")
+{
+    sparse_matrix const A = create_sparse_matrix().triangularView<Eigen::Upper>();
+    vector b = create_right_hand_side();
+    vector x = b;
+
+    REQUIRE(A.nonZeros() == 6);
+
+    SECTION("Preconditioned Conjugate Gradient")
+    {
+        json solver_data{{"type", "iterative"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("SparseLLT")
+    {
+        json solver_data{{"type", "direct"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+TEST_CASE("Reuse of the factorisation")
+{
+    sparse_matrix const A = create_sparse_matrix();
+    vector const b = create_right_hand_side();
+    vector x = b;
+
+    // A second right hand side with the solution scaled by two
+    vector const b_scaled = 2.0 * b;
+
+    for (auto const& [type, is_symmetric] : {std::pair{"iterative", true},
+                                             std::pair{"direct", true},
+                                             std::pair{"direct", false}})
+    {
+        auto linear_solver = make_linear_solver(json{{"type", type}}, is_symmetric);
+
+        REQUIRE(linear_solver->is_factorisation_reusable());
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+
+        linear_solver->solve_with_factorisation(x, b_scaled);
+
+        REQUIRE((x - 2.0 * solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+TEST_CASE("Inexact solution with a forcing term")
+{
+    sparse_matrix const A = create_sparse_matrix();
+    vector const b = create_right_hand_side();
+    vector x = b;
+
+    for (auto const& type : {"iterative", "direct"})
+    {
+        auto linear_solver = make_linear_solver(json{{"type", type}}, true);
+
+        linear_solver->set_forcing_term(0.5);
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((A * x - b).norm() <= 0.5 * b.norm());
+
+        // The tolerance of the solver applies again without a forcing term
+        linear_solver->set_forcing_term(0.0);
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+TEST_CASE("Block sparse matrix")
+{
+    // A single 3x3 block holding the test matrix
+    block_sparse_matrix<3> A;
+    A.set_structure({0, 1}, {0});
+
+    A.block(0) = create_sparse_matrix().toDense();
+
+    vector b = create_right_hand_side();
+    vector x = b;
+
+    SECTION("Basic operations")
+    {
+        REQUIRE(A.rows() == 3);
+        REQUIRE(A.cols() == 3);
+        REQUIRE(A.block_rows() == 1);
+        REQUIRE(A.blocks() == 1);
+        REQUIRE(A.nonZeros() == 9);
+
+        REQUIRE(A.coeff(1, 2) == Approx(-1.0));
+        REQUIRE(A.find_block(0, 0) == 0);
+
+        REQUIRE((A * solution() - b).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((A.to_sparse() - create_sparse_matrix()).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((A.diagonal() - vector::Constant(3, 2.0)).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Zero row and column")
+    {
+        A.zero_row_and_column(1);
+
+        REQUIRE(A.coeff(1, 1) == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE(A.block(0).row(1).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE(A.block(0).col(1).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE(A.coeff(0, 0) == Approx(2.0));
+    }
+    SECTION("Preconditioned Conjugate Gradient")
+    {
+        json solver_data{{"type", "iterative"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((A * x - b).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Direct solver fallback")
+    {
+        json solver_data{{"type", "direct"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((A * x - b).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
@@ -2,10 +2,13 @@
 #include <catch2/catch.hpp>
 
 #include "mesh/basic_mesh.hpp"
+#include "assembler/constraint_map.hpp"
 #include "mesh/material_coordinates.hpp"
 #include "assembler/mechanics/latin_matrix.hpp"
+#include "assembler/mechanics/matrix_free_operator.hpp"
 #include "mesh/mechanics/solid/mesh.hpp"
 #include "assembler/mechanics/static_matrix.hpp"
+#include "assembler/sparsity_pattern.hpp"
 #include "numeric/doublet.hpp"
 #include "io/json.hpp"
 
@@ -40,6 +43,457 @@ TEST_CASE("Doublet class")
         REQUIRE(row_col_val.value() == Approx(0.0));
     }
 }
+TEST_CASE("Sparsity pattern")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    // Reference pattern from every element matrix entry
+    std::vector<neon::doublet<std::int32_t>> doublets;
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            auto const dof_view = submesh.local_dof_view(element);
+
+            for (std::int64_t p{0}; p < dof_view.size(); ++p)
+            {
+                for (std::int64_t q{0}; q < dof_view.size(); ++q)
+                {
+                    doublets.emplace_back(dof_view(p), dof_view(q));
+                }
+            }
+        }
+    }
+    neon::sparse_matrix B(mesh.active_dofs(), mesh.active_dofs());
+    B.setFromTriplets(begin(doublets), end(doublets));
+
+    REQUIRE(A.isCompressed());
+    REQUIRE(A.rows() == B.rows());
+    REQUIRE(A.cols() == B.cols());
+    REQUIRE(A.nonZeros() == B.nonZeros());
+
+    REQUIRE(std::equal(A.outerIndexPtr(),
+                       A.outerIndexPtr() + A.outerSize() + 1,
+                       B.outerIndexPtr()));
+    REQUIRE(std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), B.innerIndexPtr()));
+
+    REQUIRE(A.coeffs().isZero());
+}
+TEST_CASE("Scatter map")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    auto const scatter_maps = neon::compute_scatter_map(A, mesh);
+
+    REQUIRE(scatter_maps.size() == mesh.meshes().size());
+
+    SECTION("Offsets match the coefficient locations")
+    {
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            std::int64_t const local_size = submesh.nodes_per_element() * submesh.dofs_per_node();
+
+            REQUIRE(scatter_maps[index].rows() == local_size * local_size);
+            REQUIRE(scatter_maps[index].cols() == submesh.elements());
+
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                auto const dof_view = submesh.local_dof_view(element);
+
+                for (std::int64_t a{0}; a < local_size; ++a)
+                {
+                    for (std::int64_t b{0}; b < local_size; ++b)
+                    {
+                        REQUIRE(A.valuePtr() + scatter_maps[index](a * local_size + b, element)
+                                == &A.coeffRef(dof_view(a), dof_view(b)));
+                    }
+                }
+            }
+        }
+    }
+    SECTION("Scatter assembly matches coefficient assembly")
+    {
+        neon::sparse_matrix B = A;
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            std::int64_t const local_size = submesh.nodes_per_element() * submesh.dofs_per_node();
+
+            neon::matrix const local_matrix = neon::matrix::Random(local_size, local_size);
+
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                auto const dof_view = submesh.local_dof_view(element);
+
+                neon::scatter_add(A, scatter_maps[index].col(element), local_matrix);
+
+                for (std::int64_t a{0}; a < local_size; ++a)
+                {
+                    for (std::int64_t b{0}; b < local_size; ++b)
+                    {
+                        B.coeffRef(dof_view(a), dof_view(b)) += local_matrix(a, b);
+                    }
+                }
+            }
+        }
+        REQUIRE((A - B).norm() == Approx(0.0).margin(1.0e-12));
+    }
+}
+TEST_CASE("Upper triangular assembly")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    neon::sparse_matrix U;
+    neon::compute_upper_sparsity_pattern(U, mesh);
+
+    SECTION("Upper pattern matches the upper triangle")
+    {
+        neon::sparse_matrix const A_upper = A.triangularView<Eigen::Upper>();
+
+        REQUIRE(U.rows() == A.rows());
+        REQUIRE(U.nonZeros() == A_upper.nonZeros());
+
+        REQUIRE(std::equal(U.outerIndexPtr(),
+                           U.outerIndexPtr() + U.outerSize() + 1,
+                           A_upper.outerIndexPtr()));
+        REQUIRE(std::equal(U.innerIndexPtr(),
+                           U.innerIndexPtr() + U.nonZeros(),
+                           A_upper.innerIndexPtr()));
+    }
+    SECTION("Upper scatter assembly matches full assembly")
+    {
+        auto const scatter_maps = neon::compute_scatter_map(A, mesh);
+        auto const upper_scatter_maps = neon::compute_upper_scatter_map(U, mesh);
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            std::int64_t const local_size = submesh.nodes_per_element() * submesh.dofs_per_node();
+
+            REQUIRE(upper_scatter_maps[index].rows() == local_size * (local_size + 1) / 2);
+
+            neon::matrix local_matrix = neon::matrix::Random(local_size, local_size);
+            local_matrix += local_matrix.transpose().eval();
+
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                neon::scatter_add(A, scatter_maps[index].col(element), local_matrix);
+                neon::scatter_add_upper(U, upper_scatter_maps[index].col(element), local_matrix);
+            }
+        }
+        neon::sparse_matrix const A_upper = A.triangularView<Eigen::Upper>();
+
+        REQUIRE((A_upper - U).norm() == Approx(0.0).margin(1.0e-12));
+
+        neon::vector const x = neon::vector::Random(A.rows());
+
+        REQUIRE((A * x - U.selfadjointView<Eigen::Upper>() * x).norm()
+                == Approx(0.0).margin(1.0e-10));
+    }
+}
+TEST_CASE("Matrix-free operator")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    mesh.update_internal_variables(0.001 * neon::vector::Random(mesh.active_dofs()));
+
+    auto const colourings = neon::colour_elements(mesh);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    auto const scatter_maps = neon::compute_scatter_map(A, mesh);
+
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+    {
+        auto const& submesh = mesh.meshes()[index];
+
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            neon::scatter_add(A,
+                              scatter_maps[index].col(element),
+                              submesh.tangent_stiffness(element));
+        }
+    }
+
+    neon::mechanics::matrix_free_operator<fem_mesh> A_operator(mesh, colourings);
+    A_operator.update();
+
+    neon::vector const x = neon::vector::Random(mesh.active_dofs());
+
+    REQUIRE(A_operator.rows() == A.rows());
+
+    SECTION("Product and diagonal match the assembled matrix")
+    {
+        REQUIRE((A_operator * x - A * x).norm() == Approx(0.0).margin(1.0e-8 * (A * x).norm()));
+        REQUIRE((A_operator.diagonal() - neon::vector(A.diagonal())).norm()
+                == Approx(0.0).margin(1.0e-8 * A.diagonal().norm()));
+    }
+    SECTION("Constrained product")
+    {
+        std::int64_t const fixed_dof = 7;
+
+        A_operator.constrain(fixed_dof);
+
+        neon::vector x_fixed = x;
+        x_fixed(fixed_dof) = 0.0;
+
+        neon::vector y = A * x_fixed;
+        y(fixed_dof) = A.coeff(fixed_dof, fixed_dof) * x(fixed_dof);
+
+        REQUIRE((A_operator * x - y).norm() == Approx(0.0).margin(1.0e-8 * y.norm()));
+    }
+}
+TEST_CASE("Constraint map")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    auto const scatter_maps = neon::compute_scatter_map(A, mesh);
+
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+    {
+        auto const& submesh = mesh.meshes()[index];
+
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            neon::scatter_add(A,
+                              scatter_maps[index].col(element),
+                              submesh.tangent_stiffness(element));
+        }
+    }
+
+    std::vector<std::int64_t> const fixed_dofs{7, 2, 11, 2, 0};
+
+    neon::constraint_map constraints;
+
+    REQUIRE(constraints.update(fixed_dofs, A.rows()));
+    REQUIRE_FALSE(constraints.update(fixed_dofs, A.rows()));
+
+    std::vector<std::int64_t> const sorted_dofs{0, 2, 7, 11};
+
+    REQUIRE(constraints.dofs() == sorted_dofs);
+    REQUIRE(constraints.free_dofs().size() == A.rows() - 4);
+
+    neon::vector const b = neon::vector::Random(A.rows());
+
+    SECTION("Masked constraints match row and column zeroing")
+    {
+        neon::matrix expected = A;
+        neon::vector expected_b = b;
+
+        for (auto const dof : constraints.dofs())
+        {
+            auto const diagonal_entry = expected(dof, dof);
+            expected.row(dof).setZero();
+            expected.col(dof).setZero();
+            expected(dof, dof) = diagonal_entry;
+            expected_b(dof) = 0.0;
+        }
+
+        neon::sparse_matrix A_masked = A;
+        neon::vector b_masked = b;
+
+        constraints.compute_positions(A_masked);
+        constraints.apply(A_masked, b_masked);
+
+        REQUIRE((neon::matrix(A_masked) - expected).norm() == Approx(0.0).margin(1.0e-12));
+        REQUIRE((b_masked - expected_b).norm() == Approx(0.0).margin(1.0e-12));
+    }
+    SECTION("Masked constraints with block storage")
+    {
+        neon::block_sparse_matrix<3> A_block;
+        neon::compute_sparsity_pattern(A_block, mesh);
+
+        auto const block_scatter_maps = neon::compute_scatter_map(A_block, mesh);
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                neon::scatter_add(A_block,
+                                  block_scatter_maps[index].col(element),
+                                  submesh.tangent_stiffness(element));
+            }
+        }
+
+        neon::sparse_matrix A_masked = A;
+        neon::vector b_masked = b, b_block = b;
+
+        constraints.compute_positions(A_masked);
+        constraints.apply(A_masked, b_masked);
+
+        constraints.compute_positions(A_block);
+        constraints.apply(A_block, b_block);
+
+        REQUIRE((A_block.to_sparse() - A_masked).norm() == Approx(0.0).margin(1.0e-12));
+        REQUIRE((b_block - b_masked).norm() == Approx(0.0).margin(1.0e-12));
+    }
+    SECTION("Eliminated constraints remove the rows and columns")
+    {
+        neon::sparse_matrix A_reduced;
+        neon::vector b_reduced, x;
+
+        constraints.compute_reduction(A, A_reduced);
+        constraints.reduce(A, A_reduced);
+        constraints.reduce(b, b_reduced);
+
+        auto const& free_dofs = constraints.free_dofs();
+
+        REQUIRE(A_reduced.rows() == static_cast<std::int64_t>(free_dofs.size()));
+
+        neon::matrix const A_dense = A;
+
+        neon::matrix expected(free_dofs.size(), free_dofs.size());
+        neon::vector expected_b(free_dofs.size());
+
+        for (std::size_t row{0}; row < free_dofs.size(); ++row)
+        {
+            expected_b(row) = b(free_dofs[row]);
+
+            for (std::size_t col{0}; col < free_dofs.size(); ++col)
+            {
+                expected(row, col) = A_dense(free_dofs[row], free_dofs[col]);
+            }
+        }
+
+        REQUIRE((neon::matrix(A_reduced) - expected).norm() == Approx(0.0).margin(1.0e-12));
+        REQUIRE((b_reduced - expected_b).norm() == Approx(0.0).margin(1.0e-12));
+
+        constraints.expand(b_reduced, x);
+
+        REQUIRE(x.size() == A.rows());
+
+        for (auto const dof : constraints.dofs())
+        {
+            REQUIRE(x(dof) == Approx(0.0).margin(1.0e-14));
+        }
+    }
+}
+TEST_CASE("Block sparse matrix assembly")
+{
+    using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    neon::sparse_matrix A;
+    neon::compute_sparsity_pattern(A, mesh);
+
+    neon::block_sparse_matrix<3> B;
+    neon::compute_sparsity_pattern(B, mesh);
+
+    SECTION("Block pattern matches the scalar pattern")
+    {
+        REQUIRE(B.rows() == A.rows());
+        REQUIRE(B.nonZeros() == A.nonZeros());
+
+        neon::sparse_matrix const C = B.to_sparse();
+
+        REQUIRE(std::equal(A.outerIndexPtr(),
+                           A.outerIndexPtr() + A.outerSize() + 1,
+                           C.outerIndexPtr()));
+        REQUIRE(std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), C.innerIndexPtr()));
+    }
+    SECTION("Block scatter assembly matches scalar assembly")
+    {
+        auto const scatter_maps = neon::compute_scatter_map(A, mesh);
+        auto const block_scatter_maps = neon::compute_scatter_map(B, mesh);
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& submesh = mesh.meshes()[index];
+
+            std::int64_t const local_size = submesh.nodes_per_element() * submesh.dofs_per_node();
+
+            REQUIRE(block_scatter_maps[index].rows() == submesh.nodes_per_element()
+                                                            * submesh.nodes_per_element());
+
+            neon::matrix const local_matrix = neon::matrix::Random(local_size, local_size);
+
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                neon::scatter_add(A, scatter_maps[index].col(element), local_matrix);
+                neon::scatter_add(B, block_scatter_maps[index].col(element), local_matrix);
+            }
+        }
+        REQUIRE((A - B.to_sparse()).norm() == Approx(0.0).margin(1.0e-12));
+
+        neon::vector const x = neon::vector::Random(A.rows());
+
+        REQUIRE((A * x - B * x).norm() == Approx(0.0).margin(1.0e-10));
+    }
+}
 TEST_CASE("Nonlinear system equilibrium solver test")
 {
     using fem_mesh = neon::mechanics::solid::mesh<neon::mechanics::solid::submesh>;
@@ -64,6 +518,155 @@ TEST_CASE("Nonlinear system equilibrium solver test")
         static_matrix matrix(mesh, json::parse(simulation_data_json()));
         matrix.solve();
     }
+    SECTION("Block storage")
+    {
+        auto block_simulation_data = json::parse(simulation_data_json());
+        block_simulation_data["linear_solver"]["storage"] = "block";
+
+        static_matrix matrix(mesh, block_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Symmetric storage")
+    {
+        auto symmetric_simulation_data = json::parse(simulation_data_json());
+        symmetric_simulation_data["linear_solver"]["storage"] = "symmetric";
+
+        static_matrix matrix(mesh, symmetric_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Modified Newton method")
+    {
+        auto modified_simulation_data = json::parse(simulation_data_json());
+        modified_simulation_data["nonlinear_options"]["method"] = "modified_newton";
+
+        static_matrix matrix(mesh, modified_simulation_data);
+        matrix.solve();
+    }
+    SECTION("BFGS method")
+    {
+        auto bfgs_simulation_data = json::parse(simulation_data_json());
+        bfgs_simulation_data["nonlinear_options"]["method"] = "bfgs";
+        bfgs_simulation_data["nonlinear_options"]["bfgs_updates"] = 5;
+        bfgs_simulation_data["linear_solver"]["dirichlet"] = "eliminated";
+
+        static_matrix matrix(mesh, bfgs_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Line search")
+    {
+        auto line_search_simulation_data = json::parse(simulation_data_json());
+        line_search_simulation_data["nonlinear_options"]["line_search"] = true;
+        line_search_simulation_data["nonlinear_options"]["line_search_iterations"] = 3;
+
+        static_matrix matrix(mesh, line_search_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Inexact Newton method")
+    {
+        auto inexact_simulation_data = json::parse(simulation_data_json());
+        inexact_simulation_data["nonlinear_options"]["inexact_newton"] = true;
+
+        static_matrix matrix(mesh, inexact_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Inexact Newton method with a direct solver")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["nonlinear_options"]["inexact_newton"] = true;
+        bad_simulation_data["linear_solver"]["type"] = "direct";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
+    SECTION("Recovery after a cutback")
+    {
+        auto cutback_simulation_data = json::parse(simulation_data_json());
+        cutback_simulation_data["nonlinear_options"]["linear_iterations"] = 3;
+
+        static_matrix matrix(mesh, cutback_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Linear predictor")
+    {
+        auto predictor_simulation_data = json::parse(simulation_data_json());
+        predictor_simulation_data["nonlinear_options"]["predictor"] = "linear";
+        predictor_simulation_data["time"]["increments"]["initial"] = 0.25;
+        predictor_simulation_data["time"]["increments"]["adaptive"] = false;
+
+        static_matrix matrix(mesh, predictor_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Quadratic predictor")
+    {
+        auto predictor_simulation_data = json::parse(simulation_data_json());
+        predictor_simulation_data["nonlinear_options"]["predictor"] = "quadratic";
+        predictor_simulation_data["time"]["increments"]["initial"] = 0.25;
+        predictor_simulation_data["time"]["increments"]["adaptive"] = false;
+
+        static_matrix matrix(mesh, predictor_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Unknown predictor")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["nonlinear_options"]["predictor"] = "PurpleMonkey";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
+    SECTION("BFGS method with block storage")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["nonlinear_options"]["method"] = "bfgs";
+        bad_simulation_data["linear_solver"]["storage"] = "block";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
+    SECTION("Unknown nonlinear method")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["nonlinear_options"]["method"] = "PurpleMonkey";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
+    SECTION("Eliminated Dirichlet conditions")
+    {
+        auto eliminated_simulation_data = json::parse(simulation_data_json());
+        eliminated_simulation_data["linear_solver"]["dirichlet"] = "eliminated";
+
+        static_matrix matrix(mesh, eliminated_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Eliminated Dirichlet conditions with symmetric storage")
+    {
+        auto eliminated_simulation_data = json::parse(simulation_data_json());
+        eliminated_simulation_data["linear_solver"]["storage"] = "symmetric";
+        eliminated_simulation_data["linear_solver"]["dirichlet"] = "eliminated";
+
+        static_matrix matrix(mesh, eliminated_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Eliminated Dirichlet conditions with block storage")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["linear_solver"]["storage"] = "block";
+        bad_simulation_data["linear_solver"]["dirichlet"] = "eliminated";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
+    SECTION("Matrix-free storage")
+    {
+        auto matrix_free_simulation_data = json::parse(simulation_data_json());
+        matrix_free_simulation_data["linear_solver"]["storage"] = "matrix_free";
+
+        static_matrix matrix(mesh, matrix_free_simulation_data);
+        matrix.solve();
+    }
+    SECTION("Unknown storage")
+    {
+        auto bad_simulation_data = json::parse(simulation_data_json());
+        bad_simulation_data["linear_solver"]["storage"] = "PurpleMonkey";
+
+        REQUIRE_THROWS_AS(static_matrix(mesh, bad_simulation_data), std::domain_error);
+    }
 }
 TEST_CASE("LATIN solver test")
 {
@@ -89,4 +692,12 @@ TEST_CASE("LATIN solver test")
         latin_matrix matrix(mesh, json::parse(simulation_data_json()));
         matrix.solve();
     }
+    SECTION("Linear predictor")
+    {
+        auto predictor_simulation_data = json::parse(simulation_data_json());
+        predictor_simulation_data["nonlinear_options"]["predictor"] = "linear";
+
+        latin_matrix matrix(mesh, predictor_simulation_data);
+        matrix.solve();
+    }
 }
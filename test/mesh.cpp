@@ -8,17 +8,51 @@
 #include "mesh/mechanics/solid/mesh.hpp"
 #include "mesh/mechanics/solid/submesh.hpp"
 #include "mesh/mechanics/solid/latin_submesh.hpp"
+#include "mesh/diffusion/heat/submesh.hpp"
+#include "graph/element_colouring.hpp"
+#include "graph/node_to_element.hpp"
 #include "io/json.hpp"
 
 #include "fixtures/cube_mesh.hpp"
+#include "fixtures/cube_submeshes.hpp"
 
 #include <range/v3/view.hpp>
 
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <set>
+
 using namespace neon;
 using namespace ranges;
 
 constexpr auto ZERO_MARGIN = 1.0e-5;
 
+/// Small strain J2 plasticity with a yield stress that is reached by the
+/// graded displacement of the cube
+json const J2_material_data = json::parse("{\"name\": \"steel\", "
+                                          "\"elastic_modulus\": 200.0e6, "
+                                          "\"poissons_ratio\": 0.3, "
+                                          "\"yield_stress\": 1.0e6, "
+                                          "\"isotropic_hardening_modulus\": 400.0e6}");
+
+json const J2_constitutive_data = json::parse("{\"name\" : \"J2_plasticity\", "
+                                              "\"finite_strain\" : false}");
+
+/// \return a vertical displacement of the cube where the axial strain grows
+/// with the height, such that only the upper quadrature points yield
+vector graded_displacement(material_coordinates const& coordinates)
+{
+    matrix3x displacement = matrix3x::Zero(3, coordinates.coordinates().cols());
+
+    displacement.row(2) = 0.01 * coordinates.coordinates().row(2).array().cube();
+
+    return Eigen::Map<vector const>(displacement.data(), displacement.size());
+}
+
 TEST_CASE("Basic mesh test")
 {
     // Read in a cube mesh from the json input file and use this to
@@ -111,6 +145,89 @@ TEST_CASE("Basic mesh test")
         }
     }
 }
+TEST_CASE("Element colouring test")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto const& submesh = basic_mesh.meshes("cube").front();
+
+    element_colouring colouring(submesh.all_node_indices());
+
+    REQUIRE(colouring.colours() > 1);
+
+    SECTION("Each element has exactly one colour")
+    {
+        std::vector<int> element_count(submesh.elements(), 0);
+
+        for (std::size_t colour{0}; colour < colouring.colours(); ++colour)
+        {
+            for (auto const element : colouring.elements(colour))
+            {
+                ++element_count[element];
+            }
+        }
+        REQUIRE(std::all_of(begin(element_count), end(element_count), [](auto const count) {
+            return count == 1;
+        }));
+    }
+    SECTION("Elements of the same colour do not share nodes")
+    {
+        for (std::size_t colour{0}; colour < colouring.colours(); ++colour)
+        {
+            std::set<std::int32_t> colour_nodes;
+
+            for (auto const element : colouring.elements(colour))
+            {
+                for (auto const node : submesh.local_node_view(element))
+                {
+                    REQUIRE(colour_nodes.insert(node).second);
+                }
+            }
+        }
+    }
+    SECTION("Deterministic colouring")
+    {
+        element_colouring other(submesh.all_node_indices());
+
+        REQUIRE(other.colours() == colouring.colours());
+
+        for (std::size_t colour{0}; colour < colouring.colours(); ++colour)
+        {
+            REQUIRE(other.elements(colour) == colouring.elements(colour));
+        }
+    }
+}
+TEST_CASE("Node to element test")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto const& submesh = basic_mesh.meshes("cube").front();
+
+    auto const& node_indices = submesh.all_node_indices();
+
+    node_to_element node_elements(node_indices, node_indices.maxCoeff() + 1);
+
+    REQUIRE(node_elements.nodes() == node_indices.maxCoeff() + 1);
+
+    SECTION("Each element node is connected once")
+    {
+        std::int64_t connections{0};
+
+        for (std::int64_t node{0}; node < node_elements.nodes(); ++node)
+        {
+            for (auto element = node_elements.begin(node); element != node_elements.end(node);
+                 ++element)
+            {
+                auto const view = submesh.local_node_view(*element);
+
+                REQUIRE((view.array() == node).count() == 1);
+
+                ++connections;
+            }
+        }
+        REQUIRE(connections == node_indices.size());
+    }
+}
 TEST_CASE("Solid submesh test")
 {
     using namespace mechanics::solid;
@@ -172,6 +289,27 @@ TEST_CASE("Solid submesh test")
 
         // Check symmetry for NeoHooke material model
         REQUIRE((stiffness - stiffness.transpose()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+
+        neon::matrix const full_stiffness = stiffness;
+
+        auto const& upper_stiffness = fem_submesh.symmetric_tangent_stiffness(0);
+
+        REQUIRE((neon::matrix(upper_stiffness.triangularView<Eigen::Upper>())
+                 - neon::matrix(full_stiffness.triangularView<Eigen::Upper>()))
+                    .norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Matrix-free tangent stiffness")
+    {
+        neon::matrix const stiffness = fem_submesh.tangent_stiffness(0);
+
+        vector const u = vector::Random(number_of_local_dofs);
+
+        REQUIRE((fem_submesh.tangent_stiffness_product(0, u) - stiffness * u).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+
+        REQUIRE((fem_submesh.tangent_stiffness_diagonal(0) - stiffness.diagonal()).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
     }
     SECTION("Internal force")
     {
@@ -181,6 +319,27 @@ TEST_CASE("Solid submesh test")
         REQUIRE(internal_force.rows() == number_of_local_dofs);
         REQUIRE(local_dofs.size() == number_of_local_dofs);
     }
+    SECTION("Fused tangent stiffness and internal force")
+    {
+        neon::matrix const stiffness = fem_submesh.tangent_stiffness(0);
+        vector const internal_force = fem_submesh.internal_force(0);
+
+        {
+            auto const [k_e, f_e] = fem_submesh.tangent_stiffness_and_internal_force(0, false);
+
+            REQUIRE((k_e - stiffness).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((f_e - internal_force).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+        {
+            auto const [k_e, f_e] = fem_submesh.tangent_stiffness_and_internal_force(0, true);
+
+            REQUIRE((neon::matrix(k_e.triangularView<Eigen::Upper>())
+                     - neon::matrix(stiffness.triangularView<Eigen::Upper>()))
+                        .norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((f_e - internal_force).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
     SECTION("Consistent and diagonal mass")
     {
         auto const local_dofs = fem_submesh.local_dof_view(0);
@@ -202,6 +361,520 @@ TEST_CASE("Solid submesh test")
         }
     }
 }
+TEST_CASE("Batched solid submesh test")
+{
+    cube_submeshes submeshes({json::object(), {{"batched", true}}});
+
+    auto& scalar_submesh = submeshes[0];
+    auto& batched_submesh = submeshes[1];
+
+    REQUIRE(scalar_submesh.batch_size() == 1);
+    REQUIRE(batched_submesh.batch_size() == mechanics::element_batch_kernel::lanes);
+
+    submeshes.perturb();
+
+    // The final batch of the 27 elements is only partially filled
+    std::vector<std::int64_t> elements(scalar_submesh.elements());
+    std::iota(begin(elements), end(elements), 0);
+
+    auto const for_each_batch = [&](auto&& function) {
+        auto const batch_size = batched_submesh.batch_size();
+
+        for (std::int64_t first{0}; first < batched_submesh.elements(); first += batch_size)
+        {
+            function(elements.data() + first,
+                     std::min(batch_size, batched_submesh.elements() - first));
+        }
+    };
+
+    SECTION("Deformation measures")
+    {
+        for (auto const name : {variable::second::displacement_gradient,
+                                variable::second::deformation_gradient})
+        {
+            auto const& scalar = scalar_submesh.internal_variables().get(name);
+            auto const& batched = batched_submesh.internal_variables().get(name);
+
+            for (std::size_t l{0}; l < scalar.size(); ++l)
+            {
+                REQUIRE((scalar[l] - batched[l]).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            }
+        }
+
+        auto const& scalar = scalar_submesh.internal_variables().get(variable::scalar::DetF);
+        auto const& batched = batched_submesh.internal_variables().get(variable::scalar::DetF);
+
+        for (std::size_t l{0}; l < scalar.size(); ++l)
+        {
+            REQUIRE(scalar[l] == Approx(batched[l]));
+        }
+    }
+    SECTION("Internal force")
+    {
+        std::int64_t evaluated{0};
+
+        for_each_batch([&](auto const* batch, auto const count) {
+            batched_submesh.internal_force(batch, count, [&](auto const element, auto const& f_e) {
+                REQUIRE((f_e - scalar_submesh.internal_force(element)).norm()
+                        == Approx(0.0).margin(ZERO_MARGIN));
+                ++evaluated;
+            });
+        });
+        REQUIRE(evaluated == scalar_submesh.elements());
+    }
+    SECTION("Tangent stiffness")
+    {
+        for_each_batch([&](auto const* batch, auto const count) {
+            batched_submesh.tangent_stiffness(batch,
+                                              count,
+                                              false,
+                                              [&](auto const element, auto const& k_e) {
+                                                  REQUIRE((k_e
+                                                           - scalar_submesh.tangent_stiffness(
+                                                               element))
+                                                              .norm()
+                                                          == Approx(0.0).margin(ZERO_MARGIN));
+                                              });
+
+            batched_submesh.tangent_stiffness(batch,
+                                              count,
+                                              true,
+                                              [&](auto const element, auto const& k_e) {
+                                                  REQUIRE((k_e
+                                                           - scalar_submesh
+                                                                 .symmetric_tangent_stiffness(
+                                                                     element))
+                                                              .norm()
+                                                          == Approx(0.0).margin(ZERO_MARGIN));
+                                              });
+        });
+    }
+    SECTION("Fused tangent stiffness and internal force")
+    {
+        for_each_batch([&](auto const* batch, auto const count) {
+            batched_submesh.tangent_stiffness_and_internal_force(
+                batch,
+                count,
+                false,
+                [&](auto const element, auto const& k_e, auto const& f_e) {
+                    REQUIRE((k_e - scalar_submesh.tangent_stiffness(element)).norm()
+                            == Approx(0.0).margin(ZERO_MARGIN));
+                    REQUIRE((f_e - scalar_submesh.internal_force(element)).norm()
+                            == Approx(0.0).margin(ZERO_MARGIN));
+                });
+        });
+    }
+}
+TEST_CASE("Batched solid submesh benchmark", "[.benchmark]")
+{
+    cube_submeshes submeshes({json::object(), {{"batched", true}}});
+
+    submeshes.perturb();
+
+    std::vector<std::int64_t> elements(submeshes[0].elements());
+    std::iota(begin(elements), end(elements), 0);
+
+    auto constexpr repetitions = 200;
+
+    for (auto const* fem_submesh : {&submeshes[0], &submeshes[1]})
+    {
+        double checksum{0.0};
+
+        auto const start = std::chrono::steady_clock::now();
+
+        for (auto repetition = 0; repetition < repetitions; ++repetition)
+        {
+            auto const batch_size = fem_submesh->batch_size();
+
+            for (std::int64_t first{0}; first < fem_submesh->elements(); first += batch_size)
+            {
+                fem_submesh->tangent_stiffness_and_internal_force(
+                    elements.data() + first,
+                    std::min(batch_size, fem_submesh->elements() - first),
+                    false,
+                    [&](auto, auto const& k_e, auto const& f_e) {
+                        checksum += k_e(0, 0) + f_e(0);
+                    });
+            }
+        }
+
+        auto const end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> const elapsed_seconds = end - start;
+
+        std::cout << "Batch size " << fem_submesh->batch_size() << " evaluated "
+                  << repetitions * fem_submesh->elements() / elapsed_seconds.count()
+                  << " elements per second (checksum " << checksum << ")\n";
+    }
+}
+TEST_CASE("Reference geometry cache test")
+{
+    cube_submeshes submeshes({json::object(),
+                              {{"cache_reference_geometry", false}},
+                              {{"cache_reference_geometry", false}, {"batched", true}}});
+
+    auto& cached_submesh = submeshes[0];
+    auto& uncached_submesh = submeshes[1];
+    auto& batched_submesh = submeshes[2];
+
+    submeshes.perturb();
+
+    SECTION("Deformation measures")
+    {
+        for (auto const name : {variable::second::displacement_gradient,
+                                variable::second::deformation_gradient})
+        {
+            auto const& cached = cached_submesh.internal_variables().get(name);
+            auto const& uncached = uncached_submesh.internal_variables().get(name);
+            auto const& batched = batched_submesh.internal_variables().get(name);
+
+            for (std::size_t l{0}; l < cached.size(); ++l)
+            {
+                REQUIRE((cached[l] - uncached[l]).norm() == Approx(0.0).margin(ZERO_MARGIN));
+                REQUIRE((cached[l] - batched[l]).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            }
+        }
+    }
+    SECTION("Consistent mass")
+    {
+        for (std::int64_t element{0}; element < cached_submesh.elements(); ++element)
+        {
+            matrix const cached = cached_submesh.consistent_mass(element);
+
+            REQUIRE((cached - uncached_submesh.consistent_mass(element)).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+}
+TEST_CASE("Packed tangent operator test")
+{
+    cube_submeshes submeshes({json::object(), {{"packed_tangent", true}, {"batched", true}}});
+
+    auto& full_submesh = submeshes[0];
+    auto& packed_submesh = submeshes[1];
+
+    submeshes.perturb();
+
+    SECTION("Storage")
+    {
+        auto const& full_variables = full_submesh.internal_variables();
+        auto const& packed_variables = packed_submesh.internal_variables();
+
+        REQUIRE_FALSE(full_variables.is_packed(variable::fourth::tangent_operator));
+        REQUIRE(packed_variables.is_packed(variable::fourth::tangent_operator));
+        REQUIRE(packed_variables.has(variable::fourth::tangent_operator));
+
+        REQUIRE(packed_variables.allocated_bytes() < full_variables.allocated_bytes());
+    }
+    SECTION("Element routines")
+    {
+        vector const u = vector::Random(8 * 3);
+
+        for (std::int64_t element{0}; element < full_submesh.elements(); ++element)
+        {
+            matrix const stiffness = full_submesh.tangent_stiffness(element);
+
+            REQUIRE((packed_submesh.tangent_stiffness(element) - stiffness).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+
+            REQUIRE((packed_submesh.tangent_stiffness_product(element, u) - stiffness * u).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+
+            REQUIRE((packed_submesh.tangent_stiffness_diagonal(element) - stiffness.diagonal())
+                        .norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+    SECTION("Batched tangent stiffness")
+    {
+        std::vector<std::int64_t> elements(full_submesh.elements());
+        std::iota(begin(elements), end(elements), 0);
+
+        auto const batch_size = packed_submesh.batch_size();
+
+        for (std::int64_t first{0}; first < packed_submesh.elements(); first += batch_size)
+        {
+            auto const count = std::min(batch_size, packed_submesh.elements() - first);
+
+            packed_submesh.tangent_stiffness(elements.data() + first,
+                                             count,
+                                             false,
+                                             [&](auto const element, auto const& k_e) {
+                                                 REQUIRE((k_e
+                                                          - full_submesh.tangent_stiffness(element))
+                                                             .norm()
+                                                         == Approx(0.0).margin(ZERO_MARGIN));
+                                             });
+        }
+    }
+}
+TEST_CASE("Shared tangent operator test")
+{
+    cube_submeshes submeshes({json::object(), {{"shared_tangent", false}}},
+                             J2_material_data,
+                             J2_constitutive_data);
+
+    auto& shared_submesh = submeshes[0];
+    auto& stored_submesh = submeshes[1];
+
+    auto const require_equal_element_routines = [&]() {
+        vector const u = vector::Random(8 * 3);
+
+        for (std::int64_t element{0}; element < stored_submesh.elements(); ++element)
+        {
+            matrix const stiffness = stored_submesh.tangent_stiffness(element);
+
+            REQUIRE((shared_submesh.tangent_stiffness(element) - stiffness).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+
+            REQUIRE((shared_submesh.tangent_stiffness_product(element, u) - stiffness * u).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+
+            REQUIRE((shared_submesh.tangent_stiffness_diagonal(element) - stiffness.diagonal())
+                        .norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    };
+
+    SECTION("Storage")
+    {
+        submeshes.perturb();
+
+        REQUIRE(shared_submesh.internal_variables().is_shared(variable::fourth::tangent_operator));
+        REQUIRE_FALSE(
+            stored_submesh.internal_variables().is_shared(variable::fourth::tangent_operator));
+    }
+    SECTION("Element routines")
+    {
+        submeshes.perturb();
+
+        require_equal_element_routines();
+    }
+    SECTION("Partially yielded")
+    {
+        submeshes.deform(graded_displacement(submeshes.mesh_coordinates()));
+
+        // The yielded points store their own tangent operator while the
+        // elastic points refer to the shared elastic moduli
+        auto const& plastic_strains = shared_submesh.internal_variables().get(
+            variable::scalar::effective_plastic_strain);
+
+        REQUIRE(std::any_of(begin(plastic_strains), end(plastic_strains), [](auto const strain) {
+            return strain > 0.0;
+        }));
+        REQUIRE(std::any_of(begin(plastic_strains), end(plastic_strains), [](auto const strain) {
+            return strain == 0.0;
+        }));
+
+        require_equal_element_routines();
+    }
+}
+TEST_CASE("Hourglass control test")
+{
+    cube_submeshes submeshes({json::object(),
+                              {{"quadrature", "reduced"}},
+                              {{"quadrature", "reduced"}, {"hourglass_coefficient", 0.0}},
+                              {{"quadrature", "reduced"}, {"batched", true}}});
+
+    auto& full_submesh = submeshes[0];
+    auto& reduced_submesh = submeshes[1];
+    auto& unstabilised_submesh = submeshes[2];
+    auto& batched_submesh = submeshes[3];
+
+    SECTION("Zero energy modes")
+    {
+        submeshes.deform(vector::Zero(64 * 3));
+
+        auto const zero_eigenvalues = [](matrix const& k_e) {
+            Eigen::SelfAdjointEigenSolver<matrix> const eigen_solver(k_e);
+
+            auto const& eigenvalues = eigen_solver.eigenvalues();
+
+            return (eigenvalues.array().abs() < 1.0e-8 * eigenvalues.cwiseAbs().maxCoeff())
+                .count();
+        };
+
+        // Six rigid body modes and twelve hourglass modes without stabilisation
+        REQUIRE(zero_eigenvalues(full_submesh.tangent_stiffness(0)) == 6);
+        REQUIRE(zero_eigenvalues(unstabilised_submesh.tangent_stiffness(0)) == 18);
+        REQUIRE(zero_eigenvalues(reduced_submesh.tangent_stiffness(0)) == 6);
+    }
+    SECTION("Homogeneous deformation")
+    {
+        matrix3 const displacement_gradient = 0.001 * matrix3::Random();
+
+        matrix3x const displacement = displacement_gradient
+                                      * submeshes.mesh_coordinates().coordinates();
+
+        submeshes.deform(Eigen::Map<vector const>(displacement.data(), displacement.size()));
+
+        // The hourglass modes are not activated and the one point rule is exact
+        for (std::int64_t element{0}; element < full_submesh.elements(); ++element)
+        {
+            vector const f_int = full_submesh.internal_force(element);
+
+            REQUIRE((reduced_submesh.internal_force(element) - f_int).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((unstabilised_submesh.internal_force(element) - f_int).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+    SECTION("Consistent element routines")
+    {
+        submeshes.perturb();
+
+        vector const u = vector::Random(8 * 3);
+
+        for (std::int64_t element{0}; element < reduced_submesh.elements(); ++element)
+        {
+            matrix const k_e = reduced_submesh.tangent_stiffness(element);
+            vector const f_int = reduced_submesh.internal_force(element);
+
+            auto const& [k_fused, f_fused] = reduced_submesh.tangent_stiffness_and_internal_force(
+                element,
+                false);
+
+            REQUIRE((k_fused - k_e).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((f_fused - f_int).norm() == Approx(0.0).margin(ZERO_MARGIN));
+
+            REQUIRE((reduced_submesh.tangent_stiffness_product(element, u) - k_e * u).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((reduced_submesh.tangent_stiffness_diagonal(element) - k_e.diagonal()).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+
+            matrix const k_upper = reduced_submesh.symmetric_tangent_stiffness(element);
+
+            REQUIRE((k_upper.triangularView<Eigen::Upper>().toDenseMatrix()
+                     - k_e.triangularView<Eigen::Upper>().toDenseMatrix())
+                        .norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+
+        std::vector<std::int64_t> elements(batched_submesh.elements());
+        std::iota(begin(elements), end(elements), 0);
+
+        for (std::int64_t first{0}; first < batched_submesh.elements();
+             first += batched_submesh.batch_size())
+        {
+            batched_submesh.tangent_stiffness_and_internal_force(
+                elements.data() + first,
+                std::min(batched_submesh.batch_size(), batched_submesh.elements() - first),
+                false,
+                [&](auto const element, auto const& k_e, auto const& f_e) {
+                    REQUIRE((k_e - reduced_submesh.tangent_stiffness(element)).norm()
+                            == Approx(0.0).margin(ZERO_MARGIN));
+                    REQUIRE((f_e - reduced_submesh.internal_force(element)).norm()
+                            == Approx(0.0).margin(ZERO_MARGIN));
+                });
+        }
+    }
+}
+TEST_CASE("Internal variable checkpoint test")
+{
+    cube_submeshes submeshes({json::object(), json::object()},
+                             J2_material_data,
+                             J2_constitutive_data);
+
+    auto& backtracked_submesh = submeshes[0];
+    auto& reference_submesh = submeshes[1];
+
+    auto& mesh_coordinates = submeshes.mesh_coordinates();
+
+    vector const u = graded_displacement(mesh_coordinates);
+
+    // Full step, rejected trial at half the step and the accepted update as
+    // performed by the line search
+    backtracked_submesh.checkpoint_internal_variables();
+
+    mesh_coordinates.update_current_configuration(u);
+    backtracked_submesh.update_internal_variables();
+
+    backtracked_submesh.restore_internal_variables();
+
+    mesh_coordinates.update_current_configuration(0.5 * u);
+    backtracked_submesh.update_stress();
+
+    backtracked_submesh.restore_internal_variables();
+    backtracked_submesh.update_internal_variables();
+
+    // A single update at the accepted displacement
+    reference_submesh.update_internal_variables();
+
+    auto const& backtracked_variables = backtracked_submesh.internal_variables();
+    auto const& reference_variables = reference_submesh.internal_variables();
+
+    auto const& backtracked_strains = backtracked_variables.get(
+        variable::scalar::effective_plastic_strain);
+    auto const& reference_strains = reference_variables.get(
+        variable::scalar::effective_plastic_strain);
+
+    REQUIRE(std::any_of(begin(reference_strains), end(reference_strains), [](auto const strain) {
+        return strain > 0.0;
+    }));
+
+    for (std::size_t l{0}; l < reference_strains.size(); ++l)
+    {
+        REQUIRE(backtracked_strains[l] == Approx(reference_strains[l]).margin(ZERO_MARGIN));
+    }
+
+    auto const& backtracked_plastic_strains = backtracked_variables.get(
+        variable::second::linearised_plastic_strain);
+    auto const& reference_plastic_strains = reference_variables.get(
+        variable::second::linearised_plastic_strain);
+
+    for (std::size_t l{0}; l < reference_plastic_strains.size(); ++l)
+    {
+        REQUIRE((backtracked_plastic_strains[l] - reference_plastic_strains[l]).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+TEST_CASE("Diffusion submesh test")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+    nodal_coordinates nodal_coordinates(json::parse(json_cube_mesh()));
+
+    auto mesh_coordinates = std::make_shared<material_coordinates>(nodal_coordinates.coordinates());
+
+    auto simulation_data = json::parse(simulation_data_json());
+    simulation_data["constitutive"] = json::parse("{\"name\" : \"isotropic_diffusion\"}");
+
+    diffusion::submesh fem_submesh(json::parse("{\"name\": \"steel\", "
+                                               "\"conductivity\": 386.0, "
+                                               "\"density\": 7800.0, "
+                                               "\"specific_heat\": 390.0}"),
+                                   simulation_data,
+                                   mesh_coordinates,
+                                   basic_mesh.meshes("cube")[0]);
+
+    fem_submesh.update_internal_variables(1.0);
+
+    SECTION("Stiffness matrix")
+    {
+        for (std::int64_t element{0}; element < fem_submesh.elements(); ++element)
+        {
+            auto const& [dofs, k_e] = fem_submesh.tangent_stiffness(element);
+
+            REQUIRE(k_e.rows() == 8);
+            REQUIRE((k_e - k_e.transpose()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+
+            // A uniform temperature field has no flux
+            REQUIRE(k_e.rowwise().sum().norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+    SECTION("Mass matrix")
+    {
+        matrix3x const& X = nodal_coordinates.coordinates();
+
+        auto const volume = (X.rowwise().maxCoeff() - X.rowwise().minCoeff()).prod();
+
+        double mass{0.0};
+
+        for (std::int64_t element{0}; element < fem_submesh.elements(); ++element)
+        {
+            mass += fem_submesh.consistent_mass(element).second.sum();
+        }
+        REQUIRE(mass == Approx(7800.0 * 390.0 * volume));
+    }
+}
 TEST_CASE("Solid mesh test")
 {
     using mechanics::solid::mesh;
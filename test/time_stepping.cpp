@@ -37,6 +37,56 @@ TEST_CASE("adaptive time control")
         REQUIRE_THROWS_AS(load.update_convergence_state(false), std::domain_error);
     }
 }
+TEST_CASE("iteration targeted time control")
+{
+    json time_data = {{"period", 1.0},
+                      {"increments",
+                       {{"initial", 0.1},
+                        {"minimum", 0.01},
+                        {"maximum", 0.3},
+                        {"adaptive", true},
+                        {"iterations", 4}}}};
+
+    adaptive_time_step load(time_data, {0.0, 0.5, 1.0});
+
+    SECTION("fast convergence grows the increment")
+    {
+        load.update_convergence_state(true, 1);
+        REQUIRE(load.step_time() == Approx(0.3));
+    }
+    SECTION("slow convergence shrinks the increment")
+    {
+        load.update_convergence_state(true, 16);
+        REQUIRE(load.step_time() == Approx(0.15));
+    }
+    SECTION("target convergence retains the increment")
+    {
+        load.update_convergence_state(true, 4);
+        REQUIRE(load.step_time() == Approx(0.2));
+    }
+    SECTION("maximum increment and mandatory time")
+    {
+        load.update_convergence_state(true, 1);
+        load.update_convergence_state(true, 1);
+        REQUIRE(load.step_time() == Approx(0.5));
+
+        load.update_convergence_state(true, 1);
+        REQUIRE(load.step_time() == Approx(0.8));
+    }
+    SECTION("no growth after a cutback")
+    {
+        load.update_convergence_state(false);
+        REQUIRE(load.step_time() == Approx(0.05));
+
+        load.update_convergence_state(true, 1);
+        REQUIRE(load.step_time() == Approx(0.1));
+    }
+    SECTION("invalid target")
+    {
+        time_data["increments"]["iterations"] = 0;
+        REQUIRE_THROWS_AS(adaptive_time_step(time_data, {0.0, 1.0}), std::domain_error);
+    }
+}
 TEST_CASE("Simple time control")
 {
     SECTION("input fuzzing")